@@ -15,16 +15,37 @@
 #ifndef APPENDER_HPP
 #define APPENDER_HPP
 
+// POSIX library
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+    #define AW_LOGGER_HAS_POSIX_IO 1
+#else
+    #define AW_LOGGER_HAS_POSIX_IO 0
+#endif
+
 // C++ standard library
 #include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <syncstream>
+#include <thread>
+#include <vector>
 
 // IXWebSocket library
 #include <ixwebsocket/IXWebSocket.h>
@@ -32,6 +53,7 @@
 // aw_logger library
 #include "aw_logger/exception.hpp"
 #include "aw_logger/formatter.hpp"
+#include "aw_logger/io_uring.hpp"
 #include "aw_logger/log_event.hpp"
 
 /***
@@ -56,7 +78,7 @@ public:
     explicit BaseAppender(): threshold_level_(LogLevel::level::DEBUG)
     {
         auto factory = std::make_unique<ComponentFactory>();
-        formatter_ = std::make_unique<Formatter>(std::move(factory));
+        formatter_.store(std::make_shared<const Formatter>(std::move(factory)), std::memory_order_release);
     }
 
     /***
@@ -88,19 +110,91 @@ public:
      */
     virtual void append(const LogEvent::Ptr& event) = 0;
 
+    /***
+     * @brief append a batch of log events drained from logger
+     * @param events batch of log events
+     * @details default implementation appends event by event, override it if appender can amortize lock or
+     * I/O cost over the whole batch
+     */
+    virtual void appendBatch(std::span<const LogEvent::Ptr> events)
+    {
+        for (const auto& event: events)
+        {
+            append(event);
+        }
+    }
+
     /***
      * @brief flush output buffer
      */
     virtual void flush() = 0;
 
+    /***
+     * @brief whether appender is able to output pre-formatted bytes, refer to `AppenderPipeline`
+     * @return true if `formatBatch()` and `writeFormatted()` are implemented
+     * @details otherwise appender is appended on worker thread of logger via `appendBatch()` as usual
+     */
+    virtual bool isFormattedWritable() const noexcept
+    {
+        return false;
+    }
+
+    /***
+     * @brief format a batch of log events into bytes without output
+     * @param out output bytes
+     * @param events batch of log events
+     * @return number of log events formatted into `out`
+     * @details it's called by format threads concurrently, so it MUST NOT touch state of output
+     */
+    virtual size_t formatBatch(std::string& out, std::span<const LogEvent::Ptr> events) const
+    {
+        (void)out;
+        (void)events;
+        throw aw_logger::invalid_parameter("appender does not support pre-formatted output!");
+    }
+
+    /***
+     * @brief output bytes formatted by `formatBatch()`
+     * @param bytes pre-formatted bytes
+     * @details it's called by I/O thread of appender
+     */
+    virtual void writeFormatted(std::string_view bytes)
+    {
+        (void)bytes;
+        throw aw_logger::invalid_parameter("appender does not support pre-formatted output!");
+    }
+
+    /***
+     * @brief output several buffers formatted by `formatBatch()` in order
+     * @param buffers pre-formatted buffers
+     * @details I/O thread hands over all the queued buffers at once, so that appender is able to gather them
+     */
+    virtual void writeFormattedBatch(std::span<const std::string_view> buffers)
+    {
+        for (const auto& bytes: buffers)
+        {
+            writeFormatted(bytes);
+        }
+    }
+
     /***
      * @brief set formatter to appender
      * @param formatter formatter to be set
+     * @details formatter is published as an immutable snapshot, so it does NOT block appends in progress,
+     * which keep formatting with the old one
      */
     void setFormatter(Formatter::Ptr formatter)
     {
-        std::lock_guard<std::mutex> lk(app_mtx_);
-        formatter_ = std::move(formatter);
+        formatter_.store(std::shared_ptr<const Formatter>(std::move(formatter)), std::memory_order_release);
+    }
+
+    /***
+     * @brief get snapshot of formatter
+     * @return immutable formatter, it keeps valid even if formatter is replaced meanwhile
+     */
+    std::shared_ptr<const Formatter> getFormatter() const noexcept
+    {
+        return formatter_.load(std::memory_order_acquire);
     }
 
     /***
@@ -123,9 +217,10 @@ public:
 
 protected:
     /***
-     * @brief formatter
+     * @brief immutable formatter, replaced as a whole in RCU style
+     * @details formatter keeps mutable caches in thread local storage, so formatting needs no lock
      */
-    Formatter::Ptr formatter_;
+    std::atomic<std::shared_ptr<const Formatter>> formatter_;
 
     /***
      * @brief log level threshold
@@ -137,21 +232,16 @@ protected:
      */
     mutable std::mutex app_mtx_;
 
-    /***
-     * @brief formatter mutex
-     */
-    mutable std::mutex fmt_mtx_;
-
     /***
      * @brief format log message
      * @param event log event
      */
-    std::string formatMsg(const LogEvent::Ptr& event)
+    std::string formatMsg(const LogEvent::Ptr& event) const
     {
-        std::lock_guard<std::mutex> lk(fmt_mtx_);
-        if (formatter_ != nullptr && event != nullptr)
-            return formatter_->formatComponents(event, formatter_->getRegisteredComponents());
-        else if (formatter_ == nullptr)
+        const auto formatter = getFormatter();
+        if (formatter != nullptr && event != nullptr)
+            return formatter->formatEvent(event);
+        else if (formatter == nullptr)
         {
             throw aw_logger::invalid_parameter("formatter is nullptr!");
         }
@@ -160,6 +250,49 @@ protected:
             throw aw_logger::invalid_parameter("event is nullptr!");
         }
     }
+
+    /***
+     * @brief format log message and append it to output buffer with EOL
+     * @param out output buffer owned by appender
+     * @param formatter snapshot of formatter, loaded once per batch
+     * @param event log event
+     */
+    static void formatMsgTo(std::string& out, const Formatter* formatter, const LogEvent::Ptr& event)
+    {
+        if (formatter == nullptr)
+            throw aw_logger::invalid_parameter("formatter is nullptr!");
+        if (event == nullptr)
+            throw aw_logger::invalid_parameter("event is nullptr!");
+
+        const auto begin = out.size();
+        formatter->formatTo(out, event);
+        /* make sure that it has EOL */
+        if (out.size() == begin || out.back() != '\n')
+            out.push_back('\n');
+    }
+
+    /***
+     * @brief format a batch of log events above log level threshold into text lines
+     * @param out output bytes
+     * @param events batch of log events
+     * @return number of formatted log events
+     */
+    size_t formatLinesTo(std::string& out, std::span<const LogEvent::Ptr> events) const
+    {
+        auto const curr_level = getThresholdLevel();
+        const auto formatter = getFormatter();
+
+        size_t event_num = 0;
+        for (const auto& event: events)
+        {
+            if (event->getLogLevel() < curr_level)
+                continue;
+
+            formatMsgTo(out, formatter.get(), event);
+            event_num++;
+        }
+        return event_num;
+    }
 };
 
 /***
@@ -186,6 +319,37 @@ public:
      */
     virtual void append(const LogEvent::Ptr& event) override;
 
+    /***
+     * @brief append a batch of log events to console within ONE synchronized emit
+     * @param events batch of log events
+     */
+    virtual void appendBatch(std::span<const LogEvent::Ptr> events) override;
+
+    /***
+     * @brief console appender outputs pre-formatted text lines
+     */
+    virtual bool isFormattedWritable() const noexcept override
+    {
+        return true;
+    }
+
+    /***
+     * @brief format a batch of log events into text lines
+     * @param out output bytes
+     * @param events batch of log events
+     * @return number of formatted log events
+     */
+    virtual size_t formatBatch(std::string& out, std::span<const LogEvent::Ptr> events) const override
+    {
+        return formatLinesTo(out, events);
+    }
+
+    /***
+     * @brief write pre-formatted text lines to console within ONE synchronized write
+     * @param bytes pre-formatted text lines
+     */
+    virtual void writeFormatted(std::string_view bytes) override;
+
     /***
      * @brief flush output stream
      */
@@ -201,6 +365,18 @@ private:
      */
     std::ostream& output_stream_;
 
+    /***
+     * @brief write buffer which log messages are formatted into, reused across appends
+     * @note guarded by `app_mtx_`
+     */
+    std::string write_buffer_;
+
+    /***
+     * @brief emit write buffer to output stream within ONE synchronized write, then clear it
+     * @note caller MUST hold `app_mtx_`
+     */
+    void emitLocked();
+
     /***
      * @brief get output stream type
      * @param stream_type stream type
@@ -214,16 +390,41 @@ private:
  */
 class FileAppender final: public BaseAppender {
 public:
+    /***
+     * @brief I/O backend of file appender
+     * @details
+     * STREAM: write through `std::ofstream`, which is portable
+     * POSIX: write through file descriptor opened with `O_APPEND`, buffers are gathered by ONE `writev()`
+     * MMAP: copy into preallocated segment mapped by `mmap()`, which makes NO syscall per flush.
+     * log file is truncated to its real size on close, but keeps zero-filled tail of segment after crash
+     * URING: submit positioned writes of all the buffers through io_uring, so that they are in flight together.
+     * fall back to POSIX if io_uring is unavailable at runtime
+     */
+    enum class ioBackend : uint8_t { STREAM, POSIX, MMAP, URING };
+
+    /***
+     * @brief default I/O backend, POSIX if available
+     */
+    static constexpr ioBackend kDefaultBackend =
+        AW_LOGGER_HAS_POSIX_IO ? ioBackend::POSIX : ioBackend::STREAM;
+
+    /***
+     * @brief default size of segment mapped by `ioBackend::MMAP`
+     */
+    static constexpr size_t kDefaultSegmentSize = 64 * 1024 * 1024;
+
     /***
      * @brief constructor
      * @param file_path path to log file
      * @param is_trunc flag for truncate file for its old logs
      * @param buffer_capacity buffer capacity of memory buffer
+     * @param backend I/O backend
      */
     explicit FileAppender(
         std::string_view file_path,
         bool is_trunc = false,
-        size_t buffer_capacity = 8192
+        size_t buffer_capacity = 8192,
+        ioBackend backend = kDefaultBackend
     );
 
     /***
@@ -232,12 +433,14 @@ public:
      * @param file_path path to log file
      * @param is_trunc flag for truncate file for its old logs
      * @param buffer_capacity buffer capacity of memory buffer
+     * @param backend I/O backend
      */
     explicit FileAppender(
         Formatter::Ptr formatter,
         std::string_view file_path,
         bool is_trunc = false,
-        size_t buffer_capacity = 8192
+        size_t buffer_capacity = 8192,
+        ioBackend backend = kDefaultBackend
     );
 
     /***
@@ -252,17 +455,58 @@ public:
     virtual void append(const LogEvent::Ptr& event) override;
 
     /***
-     * @brief flush buffer to file
+     * @brief append a batch of log events to file within ONE lock of `app_mtx_`
+     * @param events batch of log events
+     */
+    virtual void appendBatch(std::span<const LogEvent::Ptr> events) override;
+
+    /***
+     * @brief file appender outputs pre-formatted text lines
+     */
+    virtual bool isFormattedWritable() const noexcept override
+    {
+        return true;
+    }
+
+    /***
+     * @brief format a batch of log events into text lines
+     * @param out output bytes
+     * @param events batch of log events
+     * @return number of formatted log events
+     */
+    virtual size_t formatBatch(std::string& out, std::span<const LogEvent::Ptr> events) const override
+    {
+        return formatLinesTo(out, events);
+    }
+
+    /***
+     * @brief write pre-formatted text lines into memory buffer, and flush buffer once it's full
+     * @param bytes pre-formatted text lines
+     */
+    virtual void writeFormatted(std::string_view bytes) override;
+
+    /***
+     * @brief write several pre-formatted buffers, they are gathered with memory buffer into ONE write once
+     * memory buffer is gonna full
+     * @param buffers pre-formatted buffers
+     */
+    virtual void writeFormattedBatch(std::span<const std::string_view> buffers) override;
+
+    /***
+     * @brief flush buffer to file, and wait until backup files of rotated files are settled
      */
     virtual void flush() override;
 
     /***
      * @brief set max file size for rolling
+     * @details
+     * rotation switches to the next file pre-opened by a dedicated rotation thread, and backup files are
+     * shuffled on that thread, so that writing does NOT wait for them
      * @param max_size max file size in bytes
      */
     void setMaxFileSize(size_t max_size) noexcept
     {
-        max_file_size_ = max_size;
+        max_file_size_.store(max_size, std::memory_order_relaxed);
     }
 
     /***
@@ -274,6 +518,47 @@ public:
         max_backup_num_ = max_num;
     }
 
+    /***
+     * @brief set size of segment mapped by `ioBackend::MMAP`, it takes effect from the next segment
+     * @param segment_size segment size in bytes, rounded up to page size
+     */
+    void setSegmentSize(size_t segment_size) noexcept
+    {
+        segment_size_.store(segment_size, std::memory_order_relaxed);
+    }
+
+    /***
+     * @brief enable or disable asynchronous flush
+     * @param enable flag to enable asynchronous flush
+     * @param buffer_num number of memory buffers, 2 for double buffering and 3 for triple buffering
+     * @details
+     * full buffer is swapped with a free one and written by a dedicated I/O thread, so that appending does NOT
+     * wait for disk. appending blocks ONLY if all the other buffers are still in flight
+     */
+    void setAsyncFlush(bool enable, size_t buffer_num = 2);
+
+    /***
+     * @brief set durability, file data is synced to disk after each write
+     * @param is_durable flag to sync file data after each write
+     * @note
+     * ONLY `ioBackend::POSIX` and `ioBackend::URING` honor it, and io_uring links fsync after the writes.
+     * `flush()` of `ioBackend::MMAP` ONLY schedules writeback of the written range via `msync(MS_ASYNC)`,
+     * so its data survives crash of process but NOT crash of system
+     */
+    void setDurable(bool is_durable) noexcept
+    {
+        is_durable_.store(is_durable, std::memory_order_relaxed);
+    }
+
+    /***
+     * @brief check whether asynchronous flush is enabled
+     * @return true if asynchronous flush is enabled
+     */
+    inline bool isAsyncFlush() const noexcept
+    {
+        return is_async_.load(std::memory_order_acquire);
+    }
+
     /***
      * @brief get current file size
      * @return current file size in bytes
@@ -283,6 +568,15 @@ public:
         return file_size_;
     }
 
+    /***
+     * @brief get I/O backend
+     * @return I/O backend, `ioBackend::POSIX` if `ioBackend::URING` falls back
+     */
+    inline ioBackend getBackend() const noexcept
+    {
+        return backend_;
+    }
+
     /***
      * @brief reopen file
      * @param is_trunc truncate mode
@@ -295,6 +589,51 @@ private:
      */
     std::ofstream file_stream_;
 
+    /***
+     * @brief file descriptor for `ioBackend::POSIX` and `ioBackend::MMAP`, -1 means closed
+     */
+    int fd_;
+
+    /***
+     * @brief mapped segment for `ioBackend::MMAP`, `nullptr` means NOT mapped
+     */
+    char* map_;
+
+    /***
+     * @brief file offset of mapped segment
+     */
+    size_t map_begin_;
+
+    /***
+     * @brief size of mapped segment
+     */
+    size_t map_size_;
+
+    /***
+     * @brief size of segment to be mapped
+     */
+    std::atomic<size_t> segment_size_;
+
+    /***
+     * @brief I/O backend
+     */
+    ioBackend backend_;
+
+    /***
+     * @brief io_uring for `ioBackend::URING`, it's kept across rotation
+     */
+    std::unique_ptr<IoUring> ring_;
+
+    /***
+     * @brief flag to sync file data after each write
+     */
+    std::atomic<bool> is_durable_ { false };
+
+    /***
+     * @brief pieces of bytes to be gathered into ONE write, reused to avoid allocation
+     */
+    std::vector<std::string_view> pieces_;
+
     /***
      * @brief log file path
      */
@@ -305,22 +644,27 @@ private:
      */
     std::string buffer_;
 
+    /***
+     * @brief capacity of memory buffer, 0 means write through
+     */
+    size_t buffer_capacity_;
+
     /***
      * @brief current file size
      */
-    size_t file_size_;
+    std::atomic<size_t> file_size_;
 
     /***
      * @brief max file size for rotation
      * @details 0 means no size limit
      */
-    size_t max_file_size_;
+    std::atomic<size_t> max_file_size_;
 
     /***
      * @brief max number of backup files
      * @details 0 means no size limit
      */
-    size_t max_backup_num_;
+    std::atomic<size_t> max_backup_num_;
 
     /***
      * @brief flag for truncate file for its old logs
@@ -334,12 +678,94 @@ private:
     void open(bool is_trunc);
 
     /***
-     * @brief flush log messages to buffer
+     * @brief close file stream or file descriptor
+     */
+    void close() noexcept;
+
+    /***
+     * @brief check whether file is opened
+     * @return true if file is opened
+     */
+    bool isOpen() const noexcept;
+
+    /***
+     * @brief write pieces of bytes to file in order, and rotate file if needed
+     * @param pieces pieces of bytes
+     * @note caller MUST hold `io_mtx_`
+     */
+    void writePieces(std::span<const std::string_view> pieces);
+
+    /***
+     * @brief write pieces of bytes through the backend of file
+     * @param pieces pieces of bytes
+     * @param written_size number of bytes written in order, it's kept up to date even if writing throws
+     */
+    void writeBackend(std::span<const std::string_view> pieces, size_t& written_size);
+
+    /***
+     * @brief copy pieces of bytes into mapped segments, and map the next segment once it's full
+     * @param pieces pieces of bytes
+     * @param written_size number of bytes written in order, it's kept up to date even if copying throws
+     */
+    void copyToMapping(std::span<const std::string_view> pieces, size_t& written_size);
+
+    /***
+     * @brief submit positioned writes of pieces of bytes through io_uring, and wait for them
+     * @param pieces pieces of bytes
+     * @param written_size number of bytes written in order, it's kept up to date even if writing throws
+     */
+    void submitToRing(std::span<const std::string_view> pieces, size_t& written_size);
+
+    /***
+     * @brief sync file data to disk
+     */
+    void syncData();
+
+    /***
+     * @brief preallocate and map segment which begins at page of offset
+     * @param offset file offset to be written
+     */
+    void mapSegment(size_t offset);
+
+    /***
+     * @brief unmap segment
+     */
+    void unmapSegment() noexcept;
+
+    /***
+     * @brief schedule written range of mapped segment to be written back, like `msync(MS_ASYNC)`
+     */
+    void syncMapping();
+
+    /***
+     * @brief cut zero-filled tail of preallocated segment back to the last byte written, and record file size
+     * @details zero-filled tail is ONLY cut by `close()` and rotation, so it's left if process crashed,
+     * then appending to it would write after the zeros
+     */
+    void trimZeroTail();
+
+    /***
+     * @brief format log message into memory buffer directly, and flush buffer once it's full
+     * @param formatter snapshot of formatter
+     * @param event log event
+     * @note caller MUST hold `app_mtx_`
+     */
+    void appendLocked(const Formatter* formatter, const LogEvent::Ptr& event);
+
+    /***
+     * @brief flush log messages to buffer, or hand them to I/O thread if asynchronous flush is enabled
+     * @note caller MUST hold `app_mtx_`
      */
     void flushToBuffer();
 
     /***
      * @brief rotate log file while the current size is greater than max file size
+     * @details
+     * current file is renamed to a retired path and handed to rotation thread without closing it, then the next
+     * file pre-opened by rotation thread takes its place. it costs a fixed number of syscalls whatever max
+     * backup number is. without POSIX I/O, current file is closed before rename and the next file is opened
+     * in place
+     * @note caller MUST hold `io_mtx_`
      */
     void rotateFile();
 
@@ -349,6 +775,178 @@ private:
      * @return backup file path
      */
     std::filesystem::path createBackupPath(size_t index) const noexcept;
+
+    /***
+     * @brief create path of file in the middle of rotation, like `filename_next.ext`
+     * @param tag tag appended to file name
+     * @return path of file in the middle of rotation
+     */
+    std::filesystem::path createRotationPath(std::string_view tag) const noexcept;
+
+    /***
+     * @brief mutex to protect file, which is written by I/O thread while `app_mtx_` is free
+     * @note lock order is `app_mtx_` -> `io_mtx_`
+     */
+    std::mutex io_mtx_;
+
+    /***
+     * @brief mutex to protect sealed and free buffers of asynchronous flush
+     */
+    std::mutex flush_mtx_;
+
+    /***
+     * @brief condition variable to wake up I/O thread
+     */
+    std::condition_variable flush_cv_;
+
+    /***
+     * @brief condition variable to wake up appending thread once a buffer is written
+     */
+    std::condition_variable free_cv_;
+
+    /***
+     * @brief full buffers waiting to be written
+     */
+    std::deque<std::string> sealed_buffers_;
+
+    /***
+     * @brief empty buffers to be swapped with the full one
+     */
+    std::vector<std::string> free_buffers_;
+
+    /***
+     * @brief flag to indicate whether I/O thread is writing a buffer
+     */
+    bool is_writing_ = false;
+
+    /***
+     * @brief flag to stop I/O thread
+     */
+    bool is_stopping_ = false;
+
+    /***
+     * @brief flag to indicate whether asynchronous flush is enabled
+     */
+    std::atomic<bool> is_async_ { false };
+
+    /***
+     * @brief I/O thread of asynchronous flush
+     */
+    std::thread flush_thread_;
+
+    /***
+     * @brief swap full buffer with a free one, and hand it to I/O thread
+     * @note caller MUST hold `app_mtx_`
+     */
+    void sealBuffer();
+
+    /***
+     * @brief wait until all the sealed buffers are written
+     */
+    void drainFlush();
+
+    /***
+     * @brief write out sealed buffers and join I/O thread
+     */
+    void stopAsyncFlush();
+
+    /***
+     * @brief loop of I/O thread
+     */
+    void flushLoop();
+
+    /***
+     * @brief mutex to protect retired files and the next file of rotation
+     */
+    std::mutex rotate_mtx_;
+
+    /***
+     * @brief condition variable to wake up rotation thread, and threads waiting for it
+     */
+    std::condition_variable rotate_cv_;
+
+    /***
+     * @brief retired file handed to rotation thread
+     * @param path_ path of retired file, empty if it's NOT renamed
+     * @param fd_ file descriptor of retired file, -1 means closed
+     * @param stream_ file stream of retired file
+     * @param size_ real size of retired file, mapped file is truncated to it
+     */
+    struct retired_file_t {
+        std::filesystem::path path_;
+        int fd_ = -1;
+        std::ofstream stream_;
+        size_t size_ = 0;
+    };
+
+    /***
+     * @brief retired files waiting to be closed and shuffled into backup files, in order of rotation
+     * @details the front one is popped after it's shuffled
+     */
+    std::deque<retired_file_t> retired_files_;
+
+    /***
+     * @brief sequence number of retired files, so that their paths do NOT collide
+     */
+    size_t retired_seq_ = 0;
+
+    /***
+     * @brief file descriptor of the next file pre-opened by rotation thread, -1 means NOT opened
+     */
+    int next_fd_ = -1;
+
+    /***
+     * @brief file stream of the next file pre-opened by rotation thread for `ioBackend::STREAM`
+     */
+    std::ofstream next_stream_;
+
+    /***
+     * @brief flag to indicate whether the next file is pre-opened
+     */
+    bool has_next_ = false;
+
+    /***
+     * @brief flag to stop rotation thread
+     */
+    bool is_rotate_stopping_ = false;
+
+    /***
+     * @brief rotation thread which shuffles backup files and pre-opens the next file
+     */
+    std::thread rotate_thread_;
+
+    /***
+     * @brief open the next file of rotation in truncate mode, and publish it
+     * @note it's called by rotation thread without holding `rotate_mtx_`
+     */
+    void openNext();
+
+    /***
+     * @brief close retired file, then shuffle backup files and move it to the first backup: backupN -> backup(N+1)
+     * @param retired retired file
+     */
+    void retireFile(retired_file_t& retired);
+
+    /***
+     * @brief wait until all the retired files are shuffled into backup files
+     */
+    void drainRotation();
+
+    /***
+     * @brief shuffle the retired files left, remove the next file and join rotation thread
+     */
+    void stopRotation();
+
+    /***
+     * @brief loop of rotation thread
+     */
+    void rotateLoop();
+
+    /***
+     * @brief shuffle retired files left by an interrupted rotation into backup files, and remove the next file
+     * @note it's called by constructor before the file is opened
+     */
+    void sweepRotation();
 };
 
 /***
@@ -388,6 +986,29 @@ public:
      */
     virtual void append(const LogEvent::Ptr& event) override;
 
+    /***
+     * @brief websocket appender outputs pre-serialized messages
+     */
+    virtual bool isFormattedWritable() const noexcept override
+    {
+        return true;
+    }
+
+    /***
+     * @brief serialize a batch of log events into MessagePack messages, each one is prefixed by its size
+     * as 4-byte unsigned integer in network byte order(big endian)
+     * @param out output bytes
+     * @param events batch of log events
+     * @return number of serialized log events
+     */
+    virtual size_t formatBatch(std::string& out, std::span<const LogEvent::Ptr> events) const override;
+
+    /***
+     * @brief send pre-serialized messages to websocket server one by one
+     * @param bytes messages serialized by `formatBatch()`
+     */
+    virtual void writeFormatted(std::string_view bytes) override;
+
     /***
      * @brief flush buffer
      */
@@ -438,6 +1059,25 @@ private:
      */
     int handshake_timeout_;
 
+    /***
+     * @brief message buffer of `writeFormatted()`, ONLY accessed by I/O thread of appender
+     */
+    std::string frame_;
+
+    /***
+     * @brief serialize log event into MessagePack message within registered components of formatter
+     * @param out output bytes which serialized message is appended to
+     * @param formatter snapshot of formatter
+     * @param event log event
+     */
+    static void serializeTo(std::string& out, const Formatter& formatter, const LogEvent::Ptr& event);
+
+    /***
+     * @brief send serialized message to websocket server
+     * @param msg serialized message
+     */
+    void send(const std::string& msg);
+
     /***
      * @brief initialize websocket client configuration
      */
@@ -17,19 +17,31 @@
 
 // aw_logger library
 #include "aw_logger/appender.hpp"
+#include "aw_logger/call_site.hpp"
+#include "aw_logger/clock.hpp"
+#include "aw_logger/event_pool.hpp"
 #include "aw_logger/exception.hpp"
 #include "aw_logger/fmt_base.hpp"
+#include "aw_logger/format_spec.hpp"
 #include "aw_logger/formatter.hpp"
+#include "aw_logger/io_uring.hpp"
 #include "aw_logger/log_event.hpp"
 #include "aw_logger/log_macro.hpp"
 #include "aw_logger/logger.hpp"
+#include "aw_logger/pipeline.hpp"
 #include "aw_logger/ring_buffer.hpp"
 
+#include "aw_logger/impl/call_site_impl.hpp"
+#include "aw_logger/impl/clock_impl.hpp"
 #include "aw_logger/impl/console_appender_impl.hpp"
+#include "aw_logger/impl/event_pool_impl.hpp"
 #include "aw_logger/impl/file_appender_impl.hpp"
+#include "aw_logger/impl/format_spec_impl.hpp"
 #include "aw_logger/impl/formatter_impl.hpp"
+#include "aw_logger/impl/io_uring_impl.hpp"
 #include "aw_logger/impl/log_event_impl.hpp"
 #include "aw_logger/impl/logger_impl.hpp"
+#include "aw_logger/impl/pipeline_impl.hpp"
 #include "aw_logger/impl/ring_buffer_impl.hpp"
 #include "aw_logger/impl/websocket_appender_impl.hpp"
 
@@ -43,11 +55,22 @@ namespace aw_logger {
 /***
  * @brief get logger
  * @param name logger name
+ * @param capacity capacity of ringbuffer if logger is created by this call, 0 means preset or default capacity
  * @return current logger name
  */
-inline Logger::Ptr getLogger(const std::string& name = "root")
+inline Logger::Ptr getLogger(const std::string& name = "root", size_t capacity = 0)
 {
-    return LoggerManager::getInstance().getLogger(name);
+    return LoggerManager::getInstance().getLogger(name, capacity);
+}
+
+/***
+ * @brief pre-size ringbuffer of named logger before its first use
+ * @param name logger name
+ * @param capacity capacity of ringbuffer
+ */
+inline void setLoggerCapacity(const std::string& name, size_t capacity)
+{
+    LoggerManager::getInstance().setLoggerCapacity(name, capacity);
 }
 
 } // namespace aw_logger
@@ -0,0 +1,176 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef CALL_SITE_HPP
+#define CALL_SITE_HPP
+
+// C++ standard library
+#include <array>
+#include <cstddef>
+#include <source_location>
+#include <string_view>
+#include <utility>
+
+// aw_logger library
+#include "aw_logger/fmt_base.hpp"
+#include "aw_logger/format_spec.hpp"
+
+/***
+ * @brief a low-latency, high-throughput and few-dependency logger for `AwakeLion Robot Lab` project
+ * @note fundamental structure is inspired by [sylar logger](https://github.com/sylar-yin/sylar) and implement is
+ * inspired by [log4j2](https://logging.apache.org/log4j/2.12.x/) and [minilog](https://github.com/archibate/minilog)
+ * @author jinhua "siyiovo" deng
+ */
+namespace aw_logger {
+/***
+ * @brief static metadata of a log call site, including source location, log level and format string
+ * @details
+ * `AW_LOG_*` macros emit `static constexpr` call sites, so log events ONLY store a pointer to one,
+ * and formatter renders source location once per call site, refer to `Formatter::formatTo()`
+ */
+class CallSite {
+public:
+    /***
+     * @brief constructor
+     * @param level log level
+     * @param loc source location of call site
+     * @param spec pre-parsed format string of call site, `nullptr` if message is not formatted
+     */
+    constexpr CallSite(
+        LogLevel::level level,
+        const std::source_location& loc,
+        const FormatSpec* spec = nullptr
+    ) noexcept:
+        loc_(loc),
+        level_(level),
+        spec_(spec)
+    {}
+
+    /***
+     * @brief get log level
+     * @return log level
+     */
+    constexpr LogLevel::level getLogLevel() const noexcept
+    {
+        return level_;
+    }
+
+    /***
+     * @brief get source location
+     * @return source location
+     */
+    constexpr const std::source_location& getSourceLocation() const noexcept
+    {
+        return loc_;
+    }
+
+    /***
+     * @brief get pre-parsed format string
+     * @return pre-parsed format string, `nullptr` if message is not formatted
+     */
+    constexpr const FormatSpec* getFormatSpec() const noexcept
+    {
+        return spec_;
+    }
+
+    /***
+     * @brief get format string
+     * @return format string, empty if message is not formatted
+     */
+    constexpr std::string_view getFormat() const noexcept
+    {
+        return spec_ != nullptr ? spec_->get() : std::string_view();
+    }
+
+    /***
+     * @brief get call site with static storage duration for runtime log level and source location
+     * @param level log level
+     * @param loc source location of call site
+     * @return interned call site, the same one for the same level and source location
+     * @details it's for log calls without macros, e.g. `Logger::log()` with runtime log level.
+     * the number of interned call sites is bounded by log calls in source code
+     * @note each thread caches interned call sites, so the global lock is ONLY taken on its first miss
+     */
+    static const CallSite& intern(LogLevel::level level, const std::source_location& loc);
+
+private:
+    /***
+     * @brief source location
+     */
+    std::source_location loc_;
+
+    /***
+     * @brief log level
+     */
+    LogLevel::level level_;
+
+    /***
+     * @brief pre-parsed format string
+     */
+    const FormatSpec* spec_;
+};
+
+/***
+ * @brief call sites of ONE source location for each log level
+ * @details `AW_LOG_*` macros emit a `static constexpr` table, so that a runtime log level still picks
+ * a call site with static storage duration, without interning
+ */
+class CallSiteTable {
+public:
+    /***
+     * @brief constructor
+     * @param loc source location of call site
+     * @param spec pre-parsed format string of call site, `nullptr` if message is not formatted
+     */
+    constexpr explicit CallSiteTable(
+        const std::source_location& loc,
+        const FormatSpec* spec = nullptr
+    ) noexcept:
+        sites_(makeSites(loc, spec, std::make_index_sequence<LogLevel::kLevelNum>()))
+    {}
+
+    /***
+     * @brief get call site of log level
+     * @param level log level
+     * @return call site, the one of `LogLevel::level::UNKNOWN` if log level is out of range
+     */
+    constexpr const CallSite& get(LogLevel::level level) const noexcept
+    {
+        const auto index = static_cast<size_t>(level);
+        return index < sites_.size() ? sites_[index] : sites_[0];
+    }
+
+private:
+    /***
+     * @brief call sites indexed by log level
+     */
+    std::array<CallSite, LogLevel::kLevelNum> sites_;
+
+    /***
+     * @brief make call sites for each log level
+     */
+    template<size_t... Levels>
+    static constexpr std::array<CallSite, LogLevel::kLevelNum>
+    makeSites(const std::source_location& loc, const FormatSpec* spec, std::index_sequence<Levels...>) noexcept
+    {
+        return { CallSite(static_cast<LogLevel::level>(Levels), loc, spec)... };
+    }
+};
+} // namespace aw_logger
+
+// aw_logger library
+#include "impl/call_site_impl.hpp"
+
+#endif //! CALL_SITE_HPP
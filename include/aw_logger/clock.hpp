@@ -0,0 +1,195 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+// C++ standard library
+#include <chrono>
+#include <cstdint>
+
+/***
+ * @brief a low-latency, high-throughput and few-dependency logger for `AwakeLion Robot Lab` project
+ * @note fundamental structure is inspired by [sylar logger](https://github.com/sylar-yin/sylar) and implement is
+ * inspired by [log4j2](https://logging.apache.org/log4j/2.12.x/) and [minilog](https://github.com/archibate/minilog)
+ * @author jinhua "siyiovo" deng
+ */
+namespace aw_logger {
+/***
+ * @brief raw tick clock for timestamp of log event
+ */
+class TickClock {
+public:
+    /***
+     * @brief source of ticks
+     * @details
+     * SYSTEM: `std::chrono::system_clock`, ticks are wall-clock time already
+     * STEADY: `std::chrono::steady_clock`, converted to wall-clock time on worker thread
+     * TSC: cycle counter(`rdtsc` on x86, `cntvct_el0` on aarch64), converted to wall-clock time on worker thread,
+     *      fall back to STEADY if CPU has no cycle counter
+     */
+    enum class source : uint8_t { SYSTEM, STEADY, TSC };
+
+    /***
+     * @brief read current ticks
+     * @param src source of ticks
+     * @return current ticks
+     */
+    static uint64_t now(source src) noexcept;
+
+    /***
+     * @brief get whether cycle counter is available
+     * @return whether cycle counter is available
+     */
+    static constexpr bool hasTsc() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86) || defined(__aarch64__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /***
+     * @brief estimate nanoseconds per tick
+     * @param src source of ticks
+     * @return nanoseconds per tick
+     * @note cycle counter is measured against `std::chrono::steady_clock` for a few milliseconds at its first call
+     */
+    static double estimateNsPerTick(source src);
+
+private:
+    /***
+     * @brief read cycle counter
+     * @return cycle counter
+     */
+    static uint64_t readTsc() noexcept;
+};
+
+/***
+ * @brief calibrated converter from raw ticks to wall-clock time
+ * @details
+ * wall-clock time is extrapolated linearly from a base sample, i.e. `base_time + (ticks - base_ticks) * ns_per_tick`,
+ * call `recalibrate()` periodically to refit the slope and rebase against `std::chrono::system_clock`
+ * @note converter is NOT thread-safe, each worker thread owns its converters
+ */
+class TickConverter {
+public:
+    /***
+     * @brief a pair of ticks and wall-clock time taken at the same moment
+     * @param ticks_ ticks
+     * @param time_ wall-clock time
+     */
+    struct sample_t {
+        uint64_t ticks_;
+        std::chrono::sys_time<std::chrono::nanoseconds> time_;
+    };
+
+    /***
+     * @brief interval of recalibration
+     */
+    static constexpr std::chrono::nanoseconds kCalibrationInterval = std::chrono::seconds(1);
+
+    /***
+     * @brief max relative difference of refitted slope, larger one means wall-clock time jumps, so it's ignored
+     */
+    static constexpr double kMaxSkew = 0.01;
+
+    /***
+     * @brief constructor, take base sample and estimate slope of source
+     * @param src source of ticks
+     */
+    explicit TickConverter(TickClock::source src);
+
+    /***
+     * @brief constructor with given base sample and slope
+     * @param src source of ticks
+     * @param base base sample
+     * @param ns_per_tick nanoseconds per tick
+     */
+    TickConverter(TickClock::source src, const sample_t& base, double ns_per_tick) noexcept;
+
+    /***
+     * @brief take a sample of source and `std::chrono::system_clock`
+     * @param src source of ticks
+     * @return sample with the least read latency of a few tries
+     */
+    static sample_t sample(TickClock::source src) noexcept;
+
+    /***
+     * @brief refit slope from base sample to the given sample, then rebase on it
+     * @param curr current sample
+     */
+    void calibrate(const sample_t& curr) noexcept;
+
+    /***
+     * @brief calibrate on a fresh sample if `kCalibrationInterval` has passed since base sample
+     */
+    void recalibrate() noexcept;
+
+    /***
+     * @brief convert ticks to wall-clock time
+     * @param ticks ticks of the same source
+     * @return wall-clock time
+     */
+    std::chrono::sys_time<std::chrono::nanoseconds> toSysTime(uint64_t ticks) const noexcept;
+
+    /***
+     * @brief get source of ticks
+     * @return source of ticks
+     */
+    inline TickClock::source getSource() const noexcept
+    {
+        return src_;
+    }
+
+    /***
+     * @brief get nanoseconds per tick
+     * @return nanoseconds per tick
+     */
+    inline double getNsPerTick() const noexcept
+    {
+        return ns_per_tick_;
+    }
+
+    /***
+     * @brief get converter shared by threads, which is calibrated once and NEVER recalibrated
+     * @param src source of ticks
+     * @return shared converter
+     * @note it's ONLY a fallback for log events which are not converted by worker thread
+     */
+    static const TickConverter& getDefault(TickClock::source src);
+
+private:
+    /***
+     * @brief source of ticks
+     */
+    TickClock::source src_;
+
+    /***
+     * @brief base sample
+     */
+    sample_t base_;
+
+    /***
+     * @brief nanoseconds per tick
+     */
+    double ns_per_tick_;
+};
+} // namespace aw_logger
+
+// aw_logger library
+#include "impl/clock_impl.hpp"
+
+#endif //! CLOCK_HPP
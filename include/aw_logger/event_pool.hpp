@@ -0,0 +1,165 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef EVENT_POOL_HPP
+#define EVENT_POOL_HPP
+
+// C++ standard library
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// aw_logger library
+#include "aw_logger/log_event.hpp"
+#include "aw_logger/ring_buffer.hpp"
+
+/***
+ * @brief a low-latency, high-throughput and few-dependency logger for `AwakeLion Robot Lab` project
+ * @note fundamental structure is inspired by [sylar logger](https://github.com/sylar-yin/sylar) and implement is
+ * inspired by [log4j2](https://logging.apache.org/log4j/2.12.x/) and [minilog](https://github.com/archibate/minilog)
+ * @author jinhua "siyiovo" deng
+ */
+namespace aw_logger {
+/***
+ * @brief pool of log events owned by logger, log events are recycled after worker thread has appended them
+ * @details
+ * each slot holds a log event and a raw block for control block of `std::shared_ptr`,
+ * so that acquiring a log event makes NO heap allocation in steady state:
+ * (1) log event is constructed ONCE, and its message buffer keeps capacity after recycle
+ * (2) control block of `std::shared_ptr` is placed inside the slot via `SlotAllocator`
+ * (3) free slots are kept in a lock-free MPMC ringbuffer
+ * @note slots are created lazily up to capacity, if pool is exhausted it falls back to `std::make_shared`
+ */
+class EventPool: public std::enable_shared_from_this<EventPool> {
+public:
+    using Ptr = std::shared_ptr<EventPool>;
+
+    /***
+     * @brief constructor
+     * @param capacity max number of pooled log events, it will be rounded up to power of 2
+     */
+    explicit EventPool(size_t capacity);
+
+    /***
+     * @brief acquire a log event from pool
+     * @return log event, it MUST be reset before use
+     * @details it goes back to pool while the last `std::shared_ptr` is released
+     */
+    LogEvent::Ptr acquire();
+
+    /***
+     * @brief get max number of pooled log events
+     * @return max number of pooled log events
+     */
+    inline size_t getCapacity() const noexcept
+    {
+        return free_slots_.getCapacity();
+    }
+
+    /***
+     * @brief get number of slots which have been created
+     * @return number of created slots
+     */
+    inline size_t getSlotNum() const noexcept
+    {
+        return slot_num_.load(std::memory_order_relaxed);
+    }
+
+private:
+    /***
+     * @brief size of raw block for control block of `std::shared_ptr`
+     */
+    static constexpr size_t kBlockSize = 128;
+
+    /***
+     * @brief slot of pool
+     * @param event_ pooled log event
+     * @param block_ raw block for control block of `std::shared_ptr`
+     */
+    struct Slot {
+        LogEvent event_;
+        alignas(std::max_align_t) unsigned char block_[kBlockSize];
+    };
+
+    /***
+     * @brief deleter of pooled log event, it releases resources but keeps log event alive
+     */
+    struct Recycler {
+        void operator()(LogEvent* event) const noexcept
+        {
+            event->recycle();
+        }
+    };
+
+    /***
+     * @brief allocator to place control block of `std::shared_ptr` inside slot
+     * @tparam T value type, rebound to control block type by `std::shared_ptr`
+     * @details
+     * slot goes back to pool in `deallocate()`, which is the last access to the slot.
+     * it keeps pool alive via `std::shared_ptr`, so log events can safely outlive their logger
+     */
+    template<typename T>
+    class SlotAllocator {
+    public:
+        using value_type = T;
+
+        SlotAllocator(EventPool::Ptr pool, Slot* slot) noexcept: pool_(std::move(pool)), slot_(slot) {}
+
+        template<typename U>
+        SlotAllocator(const SlotAllocator<U>& other) noexcept: pool_(other.pool_), slot_(other.slot_)
+        {}
+
+        T* allocate(size_t n);
+
+        void deallocate(T* ptr, size_t n) noexcept;
+
+        template<typename U>
+        bool operator==(const SlotAllocator<U>& other) const noexcept
+        {
+            return slot_ == other.slot_;
+        }
+
+    private:
+        template<typename U>
+        friend class SlotAllocator;
+
+        EventPool::Ptr pool_;
+        Slot* slot_;
+    };
+
+    /***
+     * @brief free slots
+     */
+    RingBuffer<Slot*> free_slots_;
+
+    /***
+     * @brief number of created slots
+     */
+    std::atomic<size_t> slot_num_;
+
+    /***
+     * @brief owner of created slots
+     */
+    std::vector<std::unique_ptr<Slot>> slots_;
+
+    /***
+     * @brief mutex to protect owner of created slots
+     */
+    std::mutex slots_mtx_;
+};
+} // namespace aw_logger
+
+#endif //! EVENT_POOL_HPP
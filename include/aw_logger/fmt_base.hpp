@@ -229,12 +229,29 @@ public:
 #undef LOG_LEVEL_FUNC
     };
 
+    /***
+     * @brief number of log levels
+     */
+#define LOG_LEVEL_FUNC(name) +1
+    static constexpr size_t kLevelNum = 0 LOG_LEVEL_DEFINITION(LOG_LEVEL_FUNC);
+#undef LOG_LEVEL_FUNC
+
     /***
      * @brief convert log level to `std::string`
      * @param l log level
      * @return `std::string` of log level
      */
     static inline std::string to_string(LogLevel::level l) noexcept
+    {
+        return std::string(to_string_view(l));
+    }
+
+    /***
+     * @brief convert log level to `std::string_view` without allocation
+     * @param l log level
+     * @return `std::string_view` of log level
+     */
+    static constexpr std::string_view to_string_view(LogLevel::level l) noexcept
     {
         switch (l)
         {
@@ -0,0 +1,190 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORMAT_SPEC_HPP
+#define FORMAT_SPEC_HPP
+
+// C++ standard library
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/***
+ * @brief a low-latency, high-throughput and few-dependency logger for `AwakeLion Robot Lab` project
+ * @note fundamental structure is inspired by [sylar logger](https://github.com/sylar-yin/sylar) and implement is
+ * inspired by [log4j2](https://logging.apache.org/log4j/2.12.x/) and [minilog](https://github.com/archibate/minilog)
+ * @author jinhua "siyiovo" deng
+ */
+namespace aw_logger {
+/***
+ * @brief pre-parsed format string, which is split into literal texts and replacement fields at compile time
+ * @details
+ * `AW_LOG_FMT_*` macros keep one `static constexpr FormatSpec` per call site, so repeated calls
+ * copy literal texts directly and format each argument with its own spec instead of parsing
+ * the whole format string again via `std::vformat`. spec of each replacement field is parsed ONCE per
+ * thread into `std::formatter`, which is reused by the later calls
+ * @note format string which is NOT supported(e.g. nested replacement field like `{:{}}`, too many fields)
+ * is formatted via `std::vformat_to()` as usual
+ */
+class FormatSpec {
+public:
+    /***
+     * @brief segment of format string
+     * @param begin_ begin offset of literal text, or begin offset of spec after `:` in replacement field
+     * @param size_ size of literal text or spec
+     * @param arg_id_ index of format argument, `kLiteral` means literal text
+     */
+    struct segment_t {
+        uint16_t begin_;
+        uint16_t size_;
+        uint8_t arg_id_;
+    };
+
+    /***
+     * @brief arg id of literal text segment
+     */
+    static constexpr uint8_t kLiteral = UINT8_MAX;
+
+    /***
+     * @brief max number of segments
+     */
+    static constexpr size_t kMaxSegments = 32;
+
+    /***
+     * @brief constructor, parse format string at compile time
+     * @param fmt format string, it MUST have static storage duration, e.g. string literal
+     */
+    consteval explicit FormatSpec(std::string_view fmt);
+
+    /***
+     * @brief append formatted message to output string
+     * @tparam Args variadic template parameter
+     * @param out output string
+     * @param args variadic template parameter
+     */
+    template<typename... Args>
+    void formatTo(std::string& out, const Args&... args) const;
+
+    /***
+     * @brief get format string
+     * @return format string
+     */
+    inline constexpr std::string_view get() const noexcept
+    {
+        return fmt_;
+    }
+
+    /***
+     * @brief get whether format string is pre-parsed
+     * @return whether format string is pre-parsed
+     */
+    inline constexpr bool isParsed() const noexcept
+    {
+        return parsed_;
+    }
+
+    /***
+     * @brief get number of segments
+     * @return number of segments
+     */
+    inline constexpr size_t getSize() const noexcept
+    {
+        return size_;
+    }
+
+private:
+    /***
+     * @brief format string
+     */
+    std::string_view fmt_;
+
+    /***
+     * @brief segments of format string
+     */
+    segment_t segments_[kMaxSegments] {};
+
+    /***
+     * @brief number of segments
+     */
+    size_t size_ = 0;
+
+    /***
+     * @brief whether format string is pre-parsed
+     */
+    bool parsed_ = false;
+
+    /***
+     * @brief append a segment
+     * @return whether segment is appended, false means too many segments
+     */
+    constexpr bool addSegment(size_t begin, size_t size, uint8_t arg_id) noexcept;
+
+    /***
+     * @brief format ONE argument with its spec
+     * @tparam T type of format argument
+     * @param out output string
+     * @param spec spec after `:` in replacement field
+     * @param arg format argument
+     */
+    template<typename T>
+    static void formatArg(std::string& out, std::string_view spec, const T& arg);
+
+    /***
+     * @brief get formatter which has parsed the spec, it's parsed at the first call on each thread
+     * @tparam T type of format argument
+     * @param spec spec after `:` in replacement field, it's followed by `}` inside format string
+     * @return formatter which has parsed the spec
+     */
+    template<typename T>
+    static std::formatter<T, char>& getFormatter(std::string_view spec);
+};
+
+/***
+ * @brief format argument together with formatter which has parsed its spec
+ * @tparam T type of format argument
+ * @param arg_ format argument
+ * @param formatter_ formatter which has parsed spec of the argument
+ */
+template<typename T>
+struct parsed_arg_t {
+    const T& arg_;
+    std::formatter<T, char>* formatter_;
+};
+} // namespace aw_logger
+
+/***
+ * @brief formatter of `parsed_arg_t`, which formats argument with the formatter parsed before
+ * @tparam T type of format argument
+ */
+template<typename T>
+struct std::formatter<aw_logger::parsed_arg_t<T>, char> {
+    constexpr auto parse(std::format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    template<typename FormatContext>
+    auto format(const aw_logger::parsed_arg_t<T>& parsed, FormatContext& ctx) const
+    {
+        return parsed.formatter_->format(parsed.arg_, ctx);
+    }
+};
+
+// aw_logger library
+#include "impl/format_spec_impl.hpp"
+
+#endif //! FORMAT_SPEC_HPP
@@ -16,11 +16,18 @@
 #define FORMATTER_HPP
 
 // C++ standard library
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <format>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 // nlohmann JSON library
 #include <nlohmann/json.hpp>
@@ -41,12 +48,25 @@ namespace aw_logger {
 class ComponentFactory {
 public:
     /***
-     * @brief pattern parsing state enum
+     * @brief alignment of padded component
      * @details
-     * NORMAL_TEXT: normal text state, e.g. text insize `()` `[]` etc.
-     * PATTERN_CHAR: pattern character state, e.g. char after `%`, like `%t`, `%p`
+     * RIGHT: pad spaces on the left, default one, e.g. `%8p`
+     * LEFT: pad spaces on the right, e.g. `%-8p`
+     * CENTER: pad spaces on both sides, e.g. `%=8p`
      */
-    enum class patternState : size_t { NORMAL_TEXT, PATTERN_CHAR };
+    enum class alignType : uint8_t { RIGHT, LEFT, CENTER };
+
+    /***
+     * @brief width specification of registered component
+     * @param min_width_ min width, shorter output is padded with spaces, 0 means no padding
+     * @param max_width_ max width, longer output is truncated, 0 means no truncation
+     * @param align_ alignment of padding
+     */
+    struct component_spec_t {
+        uint16_t min_width_ = 0;
+        uint16_t max_width_ = 0;
+        alignType align_ = alignType::RIGHT;
+    };
 
     using Ptr = std::unique_ptr<ComponentFactory>;
     using ConstPtr = std::unique_ptr<const ComponentFactory>;
@@ -70,6 +90,26 @@ public:
      */
     std::vector<std::pair<std::string, std::string>> registered_components_;
 
+    /***
+     * @brief width specification of each registered component, in the same order as `registered_components_`
+     * @details components without specification, e.g. pushed by user directly, are NOT padded
+     */
+    std::vector<component_spec_t> registered_specs_;
+
+    /***
+     * @brief ANSI escape code of each log level from color component, indexed by `LogLevel::level`
+     * @details resolved once while registering components, empty means no color for that log level
+     */
+    std::array<std::string, LogLevel::kLevelNum> level_colors_;
+
+    /***
+     * @brief format color
+     * @param format `aw_logger::Color` format
+     * @return formatted color from color map
+     * @note if color is not found, return `white` format
+     */
+    static std::string formatColor(std::string_view format);
+
 private:
     /***
      * @brief log event format json from `aw_logger_settings.json`
@@ -80,7 +120,9 @@ private:
      * @brief default log event format
      */
     const nlohmann::json default_json_ = { "components",
-                                           { { { "type", "timestamp" }, { "enabled", true } },
+                                           { { { "type", "timestamp" },
+                                               { "precision", "ns" },
+                                               { "enabled", true } },
                                              { { "type", "level" }, { "enabled", true } },
                                              { { "type", "tid" }, { "enabled", true } },
                                              { { "type", "loc" },
@@ -115,8 +157,33 @@ private:
     /***
      * @brief parse runtime pattern
      * @param pattern pattern string
+     * @details
+     * each specifier is `%[align][min_width][.max_width]conversion`, e.g. `%-8p`, `%.20n`, `%=12T`,
+     * `.N` of timestamp is number of sub-second digits instead, 3(ms), 6(us) or 9(ns), e.g. `%.6t`.
+     * `%%` is a literal `%`, unknown conversion is skipped
      */
     void parsePattern(std::string_view pattern);
+
+    /***
+     * @brief register component with its width specification
+     * @param type type of component
+     * @param format unformatted data of component
+     * @param spec width specification
+     */
+    void registerComponent(std::string_view type, std::string_view format, component_spec_t spec);
+
+    /***
+     * @brief parse width specification of JSON component
+     * @param component JSON component, which may have `width`, `max_width` and `align` fields
+     * @return width specification
+     */
+    static component_spec_t parseComponentSpec(const nlohmann::json& component);
+
+    /***
+     * @brief resolve ANSI escape code of each log level
+     * @param level_colors `level_colors` of color component, e.g. `{"debug": "white", "info": "cyan"}`
+     */
+    void resolveLevelColors(const nlohmann::json& level_colors);
 };
 
 /***
@@ -128,6 +195,56 @@ public:
     using Ptr = std::unique_ptr<Formatter>;
     using ConstPtr = std::unique_ptr<const Formatter>;
 
+    /***
+     * @brief opcode of compiled component
+     * @details
+     * TEXT: literal text
+     * TIMESTAMP, LEVEL, TID, MSG: the same as component type
+     * LOCATION: source location component, rendered once per call site
+     * COLOR, END_COLOR: begin and end of level color, ONLY compiled if color component is enabled
+     * LOGGER: name of logger which the log call is made on
+     * ELAPSED: milliseconds elapsed since program start, measured on steady clock
+     * THREAD_NAME: name of caller thread, refer to `LogEvent::setThreadName()`, or thread id if it's unnamed
+     */
+    enum class opCode : uint8_t {
+        TEXT,
+        TIMESTAMP,
+        LEVEL,
+        TID,
+        LOCATION,
+        MSG,
+        COLOR,
+        END_COLOR,
+        LOGGER,
+        ELAPSED,
+        THREAD_NAME
+    };
+
+    /***
+     * @brief flat instruction compiled from registered component
+     * @param op_ opcode
+     * @param align_ alignment of padding
+     * @param digits_ number of sub-second digits, ONLY for `opCode::TIMESTAMP`
+     * @param min_width_ min width, 0 means no padding
+     * @param max_width_ max width, 0 means no truncation
+     * @param slot_ index of rendered source location cache, ONLY for `opCode::LOCATION`
+     * @param begin_ begin of span inside literal pool, for `opCode::TEXT` and `opCode::LOCATION`
+     * @param size_ size of span inside literal pool, for `opCode::TEXT` and `opCode::LOCATION`
+     * @details
+     * literal text of `opCode::TEXT` and source location format of `opCode::LOCATION` are precomputed spans
+     * of ONE literal pool, refer to `getText()`
+     */
+    struct instruction_t {
+        opCode op_;
+        ComponentFactory::alignType align_ = ComponentFactory::alignType::RIGHT;
+        uint8_t digits_ = 0;
+        uint16_t min_width_ = 0;
+        uint16_t max_width_ = 0;
+        uint16_t slot_ = 0;
+        uint32_t begin_ = 0;
+        uint32_t size_ = 0;
+    };
+
     /***
      * @brief constructor
      * @param factory component factory
@@ -142,7 +259,7 @@ public:
      * @note inspired by [fmtlib](https://github.com/fmtlib)
      */
     template<typename... Args>
-    inline std::string format(const std::format_string<Args...>&& fmt, Args&&... args)
+    inline std::string format(const std::format_string<Args...>&& fmt, Args&&... args) const
     {
         return std::format(
             std::forward<std::format_string<Args...>>(fmt),
@@ -157,7 +274,7 @@ public:
      * @param args universal parameter pack
      */
     template<typename... Args>
-    inline std::string vformat(std::string_view fmt, const Args&... args)
+    inline std::string vformat(std::string_view fmt, const Args&... args) const
     {
         return std::vformat(fmt, std::make_format_args(args...));
     }
@@ -169,49 +286,250 @@ public:
     void setFactory(ComponentFactory::Ptr factory)
     {
         factory_ = std::move(factory);
+        compile();
     }
 
+    /***
+     * @brief format log message into `std::string` via compiled instructions
+     * @param event log event
+     * @return formatted log message
+     * @details the format is able to be customized in `logger_settings.json`
+     */
+    std::string formatEvent(const LogEvent::Ptr& event) const;
+
+    /***
+     * @brief format log message and append it to output buffer via compiled instructions
+     * @param out output buffer, e.g. memory buffer owned by appender
+     * @param event log event
+     * @details no intermediate string is created, so it makes no heap allocation as long as `out` has enough
+     * capacity, except that time zone conversion of a new second is cached
+     */
+    void formatTo(std::string& out, const LogEvent::Ptr& event) const;
+
     /***
      * @brief format log message into `std::string` within registered components
      * @param event log event
      * @param components registered components ordered vector
      * @return formatted log message
-     * @details the format is able to be customized in `logger_settings.json`
+     * @note it dispatches components by comparing their types as string for each event, prefer `formatEvent()`
      */
     std::string formatComponents(
         const LogEvent::Ptr& event,
         const std::vector<std::pair<std::string, std::string>>& components
-    );
+    ) const;
 
     /***
      * @brief get registered components ordered vector
      * @return registered components ordered vector
      */
-    auto getRegisteredComponents() -> const std::vector<std::pair<std::string, std::string>>&
+    auto getRegisteredComponents() const -> const std::vector<std::pair<std::string, std::string>>&
     {
         return factory_->registered_components_;
     }
 
+    /***
+     * @brief get instructions compiled from registered components
+     * @return compiled instructions
+     */
+    auto getInstructions() const noexcept -> const std::vector<instruction_t>&
+    {
+        return instructions_;
+    }
+
+    /***
+     * @brief get literal span of instruction
+     * @param instruction `opCode::TEXT` or `opCode::LOCATION` instruction
+     * @return literal text, or source location format
+     */
+    std::string_view getText(const instruction_t& instruction) const noexcept
+    {
+        return std::string_view(literals_).substr(instruction.begin_, instruction.size_);
+    }
+
+    /***
+     * @brief get milliseconds elapsed since program start
+     * @param event log event
+     * @return elapsed milliseconds at the time log event is stamped, never negative
+     * @details
+     * it's measured on steady clock, and ONLY age of log event is taken from wall clock, which is short,
+     * so wall-clock adjustments before log event is stamped do NOT make it jump
+     */
+    static int64_t getElapsedMs(const LogEvent::Ptr& event) noexcept
+    {
+        using namespace std::chrono;
+        const auto age = std::max(system_clock::now() - event->getSysTimestamp(), system_clock::duration::zero());
+        const auto elapsed = steady_clock::now() - start_time_ - age;
+        return std::max<int64_t>(duration_cast<milliseconds>(elapsed).count(), 0);
+    }
+
 private:
     /***
      * @brief component factory provides registered components
      */
     ComponentFactory::Ptr factory_;
 
+    /***
+     * @brief instructions compiled from registered components
+     */
+    std::vector<instruction_t> instructions_;
+
+    /***
+     * @brief literal pool of all the literal spans of instructions
+     */
+    std::string literals_;
+
+    /***
+     * @brief start time of program on steady clock, for `opCode::ELAPSED`
+     */
+    static inline const std::chrono::steady_clock::time_point start_time_ =
+        std::chrono::steady_clock::now();
+
+    /***
+     * @brief ANSI escape code of each log level, copied from factory while compiling
+     */
+    std::array<std::string, LogLevel::kLevelNum> level_colors_;
+
+    /***
+     * @brief whether color component is enabled
+     */
+    bool has_color_ = false;
+
+    /***
+     * @brief unique id of compiled instructions, it's changed once the factory is set
+     */
+    uint64_t id_ = 0;
+
+    /***
+     * @brief number of `opCode::LOCATION` instructions
+     */
+    size_t location_num_ = 0;
+
+    /***
+     * @brief cached timestamp prefix of the last formatted second
+     * @param second_ the last formatted second in UTC
+     * @param prefix_ formatted local date and time of `second_`, like `[2025-10-29 22:35:38`
+     */
+    struct timestamp_cache_t {
+        std::chrono::sys_seconds second_ = std::chrono::sys_seconds::min();
+        std::string prefix_;
+    };
+
+    /***
+     * @brief rendered source location of each call site for one formatter
+     * @param id_ id of formatter
+     * @param location_caches_ one cache per `opCode::LOCATION` instruction, keyed by call site
+     * @details call sites have static storage duration, so their addresses are stable keys.
+     * the number of entries is bounded by log calls in source code
+     */
+    struct location_cache_t {
+        uint64_t id_;
+        std::vector<std::unordered_map<const CallSite*, std::string>> location_caches_;
+    };
+
+    /***
+     * @brief max number of formatters whose location caches are kept by each thread
+     */
+    static constexpr size_t kMaxLocationCaches = 8;
+
+    /***
+     * @brief get timestamp cache of current thread
+     * @return timestamp cache of current thread
+     * @note the prefix does NOT depend on formatter, so it's shared by all formatters in the same thread
+     */
+    static timestamp_cache_t& getTimestampCache() noexcept;
+
+    /***
+     * @brief get location cache of this formatter in current thread
+     * @return location cache of this formatter in current thread
+     * @details formatter is immutable once it's shared by appender, so mutable caches live in thread local storage
+     * and formatting needs no lock, the least recently created cache is evicted if there are too many formatters
+     */
+    location_cache_t& getLocationCache() const;
+
+    /***
+     * @brief append source location rendered once per call site
+     * @param out output string
+     * @param event log event
+     * @param instruction `opCode::LOCATION` instruction
+     */
+    void
+    appendLocation(std::string& out, const LogEvent::Ptr& event, const instruction_t& instruction) const;
+
+    /***
+     * @brief append log timestamp, reuse cached prefix if log event is in the same second as the last one
+     * @param out output string
+     * @param event log event
+     * @param digits number of sub-second digits, 3(ms), 6(us) or 9(ns)
+     */
+    void appendTimestamp(std::string& out, const LogEvent::Ptr& event, size_t digits) const;
+
+    /***
+     * @brief append thread name, or thread id if the thread is unnamed
+     * @param out output string
+     * @param event log event
+     */
+    static void appendThreadName(std::string& out, const LogEvent::Ptr& event)
+    {
+        const auto thread_name = event->getThreadName();
+        if (thread_name.empty())
+        {
+            std::format_to(std::back_inserter(out), "[tid: {}]", event->getThreadId());
+            return;
+        }
+        out += '[';
+        out += thread_name;
+        out += ']';
+    }
+
+
+    /***
+     * @brief get number of sub-second digits from timestamp precision
+     * @param precision timestamp precision, "ms", "us" or "ns", empty means "ns"
+     * @return number of sub-second digits
+     */
+    static size_t getTimestampDigits(std::string_view precision);
+
+    /***
+     * @brief compile registered components of factory into instructions
+     * @details it's called once the factory is set, so formatting is a loop over opcodes without string comparison
+     */
+    void compile();
+
+    /***
+     * @brief append literal text instruction, merged into the last one if it's also literal text
+     * @param text literal text
+     */
+    void compileText(std::string_view text);
+
+    /***
+     * @brief compile source location format into instruction with its own rendered location cache
+     * @param format source location format, e.g. `[{file_name}:{function_name}:{line}]`
+     * @param spec width specification
+     */
+    void compileSourceLocation(std::string_view format, const ComponentFactory::component_spec_t& spec);
+
+    /***
+     * @brief pad or truncate output of instruction according to its width specification
+     * @param out output string
+     * @param begin begin of output of instruction
+     * @param instruction instruction with width specification
+     */
+    static void applyWidth(std::string& out, size_t begin, const instruction_t& instruction);
+
     /***
      * @brief format color
      * @param format `aw_logger::Color` format
      * @return formatted color from color map
      * @note if color is not found, return `white` format
      */
-    std::string formatColor(std::string_view format);
+    std::string formatColor(std::string_view format) const;
 
     /***
      * @brief format log message
      * @param event log event
      * @return formatted log message
      */
-    std::string formatMsg(const LogEvent::Ptr& event)
+    std::string formatMsg(const LogEvent::Ptr& event) const
     {
         return event->getMsg();
     }
@@ -221,7 +539,7 @@ private:
      * @param event log event
      * @return formatted log level
      */
-    std::string formatLevel(const LogEvent::Ptr& event)
+    std::string formatLevel(const LogEvent::Ptr& event) const
     {
         auto level = event->getLogLevelString();
         return Formatter::vformat("[{}]", level);
@@ -232,7 +550,7 @@ private:
      * @param event log event
      * @return formatted log timestamp
      */
-    std::string formatTimestamp(const LogEvent::Ptr& event)
+    std::string formatTimestamp(const LogEvent::Ptr& event) const
     {
         auto timestamp = event->getTimestamp();
         return Formatter::vformat("[{}]", timestamp);
@@ -243,17 +561,46 @@ private:
      * @param format source location format
      * @return formatted log source location
      */
-    std::string formatSourceLocation(const LogEvent::Ptr& event, std::string_view format);
+    std::string formatSourceLocation(const LogEvent::Ptr& event, std::string_view format) const;
 
     /***
      * @brief format log thread id
      * @return formatted log thread id
      */
-    std::string formatThreadId(const LogEvent::Ptr& event)
+    std::string formatThreadId(const LogEvent::Ptr& event) const
     {
         auto tid = event->getThreadId();
         return Formatter::vformat("[tid: {}]", tid);
     }
+
+    /***
+     * @brief format logger name
+     * @return formatted logger name
+     */
+    std::string formatLoggerName(const LogEvent::Ptr& event) const
+    {
+        return Formatter::vformat("[{}]", event->getLoggerName());
+    }
+
+    /***
+     * @brief format milliseconds elapsed since program start
+     * @return formatted elapsed time
+     */
+    std::string formatElapsed(const LogEvent::Ptr& event) const
+    {
+        return Formatter::vformat("[{}ms]", getElapsedMs(event));
+    }
+
+    /***
+     * @brief format thread name, or thread id if the thread is unnamed
+     * @return formatted thread name
+     */
+    std::string formatThreadName(const LogEvent::Ptr& event) const
+    {
+        std::string result;
+        appendThreadName(result, event);
+        return result;
+    }
 };
 
 } // namespace aw_logger
@@ -0,0 +1,61 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef IMPL__CALL_SITE_IMPL_HPP
+#define IMPL__CALL_SITE_IMPL_HPP
+
+// C++ standard library
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+// aw_logger library
+#include "aw_logger/call_site.hpp"
+
+namespace aw_logger {
+inline const CallSite& CallSite::intern(LogLevel::level level, const std::source_location& loc)
+{
+    /* strings of `std::source_location` have static storage duration, so their addresses identify call site */
+    using key_t = std::tuple<uintptr_t, uintptr_t, uint_least32_t, uint_least32_t, LogLevel::level>;
+
+    static std::mutex intern_mtx;
+    /* nodes of `std::map` are never moved, so references to interned call sites stay valid */
+    static std::map<key_t, CallSite> interned_sites;
+    /* cache of this thread in front of interned call sites, so that hit path is free of lock */
+    thread_local std::map<key_t, const CallSite*> cached_sites;
+
+    const key_t key { reinterpret_cast<uintptr_t>(loc.file_name()),
+                      reinterpret_cast<uintptr_t>(loc.function_name()),
+                      loc.line(),
+                      loc.column(),
+                      level };
+
+    auto it = cached_sites.find(key);
+    if (it != cached_sites.end())
+        return *it->second;
+
+    const CallSite* site = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(intern_mtx);
+        site = &interned_sites.try_emplace(key, level, loc).first->second;
+    }
+    cached_sites.emplace(key, site);
+    return *site;
+}
+
+} // namespace aw_logger
+
+#endif //! IMPL__CALL_SITE_IMPL_HPP
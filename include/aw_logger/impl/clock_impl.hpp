@@ -0,0 +1,198 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMPL__CLOCK_IMPL_HPP
+#define IMPL__CLOCK_IMPL_HPP
+
+// C++ standard library
+#include <cmath>
+#include <limits>
+
+// platform intrinsic
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+// aw_logger library
+#include "aw_logger/clock.hpp"
+
+namespace aw_logger {
+inline uint64_t TickClock::now(source src) noexcept
+{
+    switch (src)
+    {
+        case source::STEADY:
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        case source::TSC:
+            if constexpr (hasTsc())
+                return readTsc();
+            else
+                return now(source::STEADY);
+        default:
+            return static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    }
+}
+
+inline uint64_t TickClock::readTsc() noexcept
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    /* constant and invariant TSC is assumed, which is true for most x86 CPUs in the last decade */
+    return static_cast<uint64_t>(__rdtsc());
+#elif defined(__aarch64__)
+    /* virtual counter of generic timer runs at a fixed frequency */
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return now(source::STEADY);
+#endif
+}
+
+inline double TickClock::estimateNsPerTick(source src)
+{
+    const auto period_ns = [](auto clock) {
+        using period = typename decltype(clock)::period;
+        return static_cast<double>(period::num) * 1e9 / static_cast<double>(period::den);
+    };
+
+    switch (src)
+    {
+        case source::STEADY:
+            return period_ns(std::chrono::steady_clock());
+        case source::TSC:
+        {
+            if constexpr (!hasTsc())
+                return period_ns(std::chrono::steady_clock());
+
+            /* measure cycle counter against steady clock ONCE */
+            static const double ns_per_tick = []() {
+                const auto begin_time = std::chrono::steady_clock::now();
+                const auto begin_ticks = readTsc();
+                auto end_time = begin_time;
+                while (end_time - begin_time < std::chrono::milliseconds(5))
+                {
+                    end_time = std::chrono::steady_clock::now();
+                }
+                const auto end_ticks = readTsc();
+                const auto elapsed =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time);
+                return static_cast<double>(elapsed.count())
+                    / static_cast<double>(end_ticks - begin_ticks);
+            }();
+            return ns_per_tick;
+        }
+        default:
+            return period_ns(std::chrono::system_clock());
+    }
+}
+
+inline TickConverter::TickConverter(TickClock::source src):
+    src_(src),
+    base_(sample(src)),
+    ns_per_tick_(TickClock::estimateNsPerTick(src))
+{}
+
+inline TickConverter::TickConverter(
+    TickClock::source src,
+    const sample_t& base,
+    double ns_per_tick
+) noexcept:
+    src_(src),
+    base_(base),
+    ns_per_tick_(ns_per_tick)
+{}
+
+inline TickConverter::sample_t TickConverter::sample(TickClock::source src) noexcept
+{
+    /* the sample with the least read latency is the most accurate one */
+    sample_t best {};
+    uint64_t best_spread = std::numeric_limits<uint64_t>::max();
+    for (int i = 0; i < 3; i++)
+    {
+        const uint64_t begin_ticks = TickClock::now(src);
+        const auto time = std::chrono::system_clock::now();
+        const uint64_t end_ticks = TickClock::now(src);
+        if (end_ticks - begin_ticks < best_spread)
+        {
+            best_spread = end_ticks - begin_ticks;
+            best.ticks_ = begin_ticks + best_spread / 2;
+            best.time_ = std::chrono::time_point_cast<std::chrono::nanoseconds>(time);
+        }
+    }
+    return best;
+}
+
+inline void TickConverter::calibrate(const sample_t& curr) noexcept
+{
+    if (curr.ticks_ > base_.ticks_ && curr.time_ > base_.time_)
+    {
+        const double slope = static_cast<double>((curr.time_ - base_.time_).count())
+            / static_cast<double>(curr.ticks_ - base_.ticks_);
+        if (std::abs(slope / ns_per_tick_ - 1.0) <= kMaxSkew)
+            ns_per_tick_ = slope;
+    }
+    /* follow wall-clock time even if it jumps */
+    base_ = curr;
+}
+
+inline void TickConverter::recalibrate() noexcept
+{
+    const uint64_t ticks = TickClock::now(src_);
+    const double elapsed = static_cast<double>(ticks - base_.ticks_) * ns_per_tick_;
+    if (elapsed < static_cast<double>(kCalibrationInterval.count()))
+        return;
+
+    calibrate(sample(src_));
+}
+
+inline std::chrono::sys_time<std::chrono::nanoseconds>
+TickConverter::toSysTime(uint64_t ticks) const noexcept
+{
+    /* signed delta, log event may be stamped before base sample */
+    const auto delta = static_cast<int64_t>(ticks - base_.ticks_);
+    return base_.time_
+        + std::chrono::nanoseconds(std::llround(static_cast<double>(delta) * ns_per_tick_));
+}
+
+inline const TickConverter& TickConverter::getDefault(TickClock::source src)
+{
+    switch (src)
+    {
+        case TickClock::source::STEADY:
+        {
+            static const TickConverter steady_converter(TickClock::source::STEADY);
+            return steady_converter;
+        }
+        case TickClock::source::TSC:
+        {
+            static const TickConverter tsc_converter(TickClock::source::TSC);
+            return tsc_converter;
+        }
+        default:
+        {
+            /* ticks of system clock are wall-clock time since epoch */
+            static const TickConverter system_converter(
+                TickClock::source::SYSTEM,
+                sample_t { 0, std::chrono::sys_time<std::chrono::nanoseconds>() },
+                TickClock::estimateNsPerTick(TickClock::source::SYSTEM)
+            );
+            return system_converter;
+        }
+    }
+}
+} // namespace aw_logger
+
+#endif //! IMPL__CLOCK_IMPL_HPP
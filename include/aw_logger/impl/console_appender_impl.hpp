@@ -41,9 +41,49 @@ void ConsoleAppender::append(const LogEvent::Ptr& event)
     if (event->getLogLevel() < curr_level)
         return;
 
-    auto log_msg = formatMsg(event);
-    /* create temporary osyncstream - automatically emits on destruction for thread-safe output */
-    std::osyncstream(output_stream_) << log_msg << std::endl;
+    const auto formatter = getFormatter();
+    std::lock_guard<std::mutex> app_lk(app_mtx_);
+    formatMsgTo(write_buffer_, formatter.get(), event);
+    emitLocked();
+}
+
+void ConsoleAppender::appendBatch(std::span<const LogEvent::Ptr> events)
+{
+    auto const curr_level = getThresholdLevel();
+
+    const auto formatter = getFormatter();
+
+    std::lock_guard<std::mutex> app_lk(app_mtx_);
+    for (const auto& event: events)
+    {
+        if (event->getLogLevel() < curr_level)
+            continue;
+
+        formatMsgTo(write_buffer_, formatter.get(), event);
+    }
+
+    emitLocked();
+}
+
+void ConsoleAppender::writeFormatted(std::string_view bytes)
+{
+    std::lock_guard<std::mutex> app_lk(app_mtx_);
+    write_buffer_.append(bytes);
+    emitLocked();
+}
+
+inline void ConsoleAppender::emitLocked()
+{
+    if (write_buffer_.empty())
+        return;
+
+    /* emit the whole buffer at once, then flush like `std::endl` does */
+    std::osyncstream(output_stream_)
+            .write(write_buffer_.data(), static_cast<std::streamsize>(write_buffer_.size()))
+        << std::flush;
+
+    /* keep capacity for the next append */
+    write_buffer_.clear();
 }
 
 inline std::ostream& aw_logger::ConsoleAppender::getStreamType(std::string_view stream_type)
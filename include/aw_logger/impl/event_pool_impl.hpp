@@ -0,0 +1,68 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMPL__EVENT_POOL_IMPL_HPP
+#define IMPL__EVENT_POOL_IMPL_HPP
+
+// aw_logger library
+#include "aw_logger/event_pool.hpp"
+
+namespace aw_logger {
+inline EventPool::EventPool(size_t capacity): free_slots_(capacity), slot_num_(0)
+{}
+
+inline LogEvent::Ptr EventPool::acquire()
+{
+    Slot* slot = nullptr;
+    if (!free_slots_.pop(slot))
+    {
+        /* pool is exhausted, fall back to heap allocation */
+        if (slot_num_.fetch_add(1, std::memory_order_relaxed) >= getCapacity())
+        {
+            slot_num_.fetch_sub(1, std::memory_order_relaxed);
+            return std::make_shared<LogEvent>();
+        }
+
+        /* create slot lazily, ONLY happens while warming up */
+        auto new_slot = std::make_unique<Slot>();
+        slot = new_slot.get();
+        std::lock_guard<std::mutex> slots_lk(slots_mtx_);
+        slots_.emplace_back(std::move(new_slot));
+    }
+
+    return LogEvent::Ptr(&slot->event_, Recycler {}, SlotAllocator<LogEvent>(shared_from_this(), slot));
+}
+
+template<typename T>
+T* EventPool::SlotAllocator<T>::allocate(size_t n)
+{
+    if (sizeof(T) * n <= kBlockSize && alignof(T) <= alignof(std::max_align_t))
+        return reinterpret_cast<T*>(slot_->block_);
+
+    /* control block does not fit in the slot, it's unexpected but still correct */
+    return std::allocator<T>().allocate(n);
+}
+
+template<typename T>
+void EventPool::SlotAllocator<T>::deallocate(T* ptr, size_t n) noexcept
+{
+    if (reinterpret_cast<unsigned char*>(ptr) != slot_->block_)
+        std::allocator<T>().deallocate(ptr, n);
+
+    /* capacity of free slots equals to max number of slots, so push never fails */
+    pool_->free_slots_.push(slot_);
+}
+} // namespace aw_logger
+
+#endif //! IMPL__EVENT_POOL_IMPL_HPP
@@ -15,6 +15,11 @@
 #ifndef IMPL__FILE_APPENDER_IMPL_HPP
 #define IMPL__FILE_APPENDER_IMPL_HPP
 
+// C++ standard library
+#include <algorithm>
+#include <array>
+#include <limits>
+
 // aw_logger library
 #include "aw_logger/appender.hpp"
 
@@ -28,10 +33,18 @@ namespace aw_logger {
 inline FileAppender::FileAppender(
     std::string_view file_path,
     bool is_trunc,
-    size_t buffer_capacity
+    size_t buffer_capacity,
+    ioBackend backend
 ):
+    fd_(-1),
+    map_(nullptr),
+    map_begin_(0),
+    map_size_(0),
+    segment_size_(kDefaultSegmentSize),
+    backend_(backend),
     file_path_(file_path),
     buffer_(),
+    buffer_capacity_(buffer_capacity),
     file_size_(0),
     max_file_size_(0),
     max_backup_num_(5),
@@ -40,6 +53,9 @@ inline FileAppender::FileAppender(
     /* reserve buffer capacity without initializing */
     buffer_.reserve(buffer_capacity);
 
+    /* settle files left by a rotation which was interrupted by process exit */
+    sweepRotation();
+
     /* get current file size if exists the file and is not truncated */
     if (std::filesystem::exists(file_path_) && !is_trunc_)
         file_size_ = std::filesystem::file_size(file_path_);
@@ -51,11 +67,19 @@ inline FileAppender::FileAppender(
     Formatter::Ptr formatter,
     std::string_view file_path,
     bool is_trunc,
-    size_t buffer_capacity
+    size_t buffer_capacity,
+    ioBackend backend
 ):
     BaseAppender(std::move(formatter)),
+    fd_(-1),
+    map_(nullptr),
+    map_begin_(0),
+    map_size_(0),
+    segment_size_(kDefaultSegmentSize),
+    backend_(backend),
     file_path_(file_path),
     buffer_(),
+    buffer_capacity_(buffer_capacity),
     file_size_(0),
     max_file_size_(0),
     max_backup_num_(5),
@@ -63,6 +87,8 @@ inline FileAppender::FileAppender(
 {
     buffer_.reserve(buffer_capacity);
 
+    sweepRotation();
+
     if (std::filesystem::exists(file_path_) && !is_trunc_)
         file_size_ = std::filesystem::file_size(file_path_);
 
@@ -72,39 +98,105 @@ inline FileAppender::FileAppender(
 inline FileAppender::~FileAppender()
 {
     flush();
-
-    if (file_stream_.is_open())
-        file_stream_.close();
+    stopAsyncFlush();
+    stopRotation();
+    close();
 }
 
 inline void FileAppender::open(bool is_trunc)
 {
-    /* check file stream */
-    if (file_stream_.is_open())
-    {
-        file_stream_.flush();
-        file_stream_.close();
-    }
+    /* check file stream or file descriptor */
+    close();
 
     /* if directory did not exist, create one */
     if (!file_path_.parent_path().empty())
         std::filesystem::create_directories(file_path_.parent_path());
 
-    /**
-     * select open mode
-     * NOTE that if did not exist file, ofstream will create automatically
-     */
-    auto open_mode =
-        (std::ios::out | std::ios::binary) | (is_trunc ? std::ios::trunc : std::ios::app);
-    file_stream_.open(file_path_, open_mode);
+    /* detect io_uring at runtime, and fall back to plain write path if it's unavailable */
+    if (backend_ == ioBackend::URING && ring_ == nullptr)
+    {
+        try
+        {
+            if (IoUring::isAvailable())
+                ring_ = std::make_unique<IoUring>();
+        } catch (const aw_logger::aw_logger_exception&)
+        {
+            ring_ = nullptr;
+        }
 
-    if (!file_stream_.is_open())
-        throw aw_logger::aw_logger_exception("can not open file: " + file_path_.string());
+        if (ring_ == nullptr)
+            backend_ = ioBackend::POSIX;
+    }
+
+    if (backend_ != ioBackend::STREAM)
+    {
+#if AW_LOGGER_HAS_POSIX_IO
+        /**
+         * O_APPEND makes each write of POSIX backend land at the end of file atomically in both modes,
+         * mapping needs read permission, while mapping and io_uring write at their own offsets without it
+         */
+        const int flags = O_CREAT | O_CLOEXEC | (is_trunc ? O_TRUNC : 0)
+            | (backend_ == ioBackend::MMAP ? O_RDWR : O_WRONLY)
+            | (backend_ == ioBackend::POSIX ? O_APPEND : 0);
+        fd_ = ::open(file_path_.c_str(), flags, 0644);
+        if (fd_ < 0)
+            throw aw_logger::aw_logger_exception(
+                "can not open file: " + file_path_.string() + ", " + std::strerror(errno)
+            );
+
+        /* crash may leave zero-filled tail of preallocated segment, appending goes right after the last byte */
+        if (backend_ == ioBackend::MMAP && !is_trunc)
+            trimZeroTail();
+#else
+        throw aw_logger::invalid_parameter("POSIX or MMAP I/O backend is not available on this platform!");
+#endif
+    }
+    else
+    {
+        /**
+         * select open mode
+         * NOTE that if did not exist file, ofstream will create automatically
+         */
+        auto open_mode =
+            (std::ios::out | std::ios::binary) | (is_trunc ? std::ios::trunc : std::ios::app);
+        file_stream_.open(file_path_, open_mode);
+
+        if (!file_stream_.is_open())
+            throw aw_logger::aw_logger_exception("can not open file: " + file_path_.string());
+    }
 
     if (is_trunc)
         file_size_ = 0;
 }
 
+inline void FileAppender::close() noexcept
+{
+#if AW_LOGGER_HAS_POSIX_IO
+    if (fd_ >= 0)
+    {
+        /* cut zero-filled tail of preallocated segment */
+        if (backend_ == ioBackend::MMAP)
+        {
+            unmapSegment();
+            static_cast<void>(::ftruncate(fd_, static_cast<off_t>(file_size_)));
+        }
+        ::close(fd_);
+        fd_ = -1;
+    }
+#endif
+
+    if (file_stream_.is_open())
+    {
+        file_stream_.flush();
+        file_stream_.close();
+    }
+}
+
+inline bool FileAppender::isOpen() const noexcept
+{
+    return backend_ == ioBackend::STREAM ? file_stream_.is_open() : fd_ >= 0;
+}
+
 void FileAppender::append(const LogEvent::Ptr& event)
 {
     /* check status of log level */
@@ -112,45 +204,94 @@ void FileAppender::append(const LogEvent::Ptr& event)
     if (event->getLogLevel() < curr_level)
         return;
 
-    auto log_msg = formatMsg(event);
-    /* make sure that it has EOF */
-    if (log_msg.empty() || log_msg.back() != '\n')
-        log_msg.push_back('\n');
-    const auto log_msg_size = log_msg.size();
+    const auto formatter = getFormatter();
+    std::lock_guard<std::mutex> app_lk(app_mtx_);
+    appendLocked(formatter.get(), event);
+}
+
+void FileAppender::appendBatch(std::span<const LogEvent::Ptr> events)
+{
+    auto const curr_level = getThresholdLevel();
+
+    const auto formatter = getFormatter();
 
     std::lock_guard<std::mutex> app_lk(app_mtx_);
-    /* check if buffer needs flush before append */
-    if (buffer_.capacity() == 0)
+    for (const auto& event: events)
     {
-        /* if file stream is close, reopen it in append mode */
-        if (!file_stream_.is_open())
-            open(false);
+        if (event->getLogLevel() < curr_level)
+            continue;
 
-        /* write into file and record file size */
-        file_stream_.write(log_msg.data(), static_cast<std::streamsize>(log_msg_size));
-        if (!file_stream_.good())
-            throw aw_logger::aw_logger_exception("failed to write to file: " + file_path_.string());
-        file_size_ += log_msg_size;
-
-        /* if file size is greater than max file size, rotate */
-        if (max_file_size_ > 0 && file_size_ >= max_file_size_)
-            rotateFile();
-        return;
+        appendLocked(formatter.get(), event);
     }
+}
+
+inline void FileAppender::appendLocked(const Formatter* formatter, const LogEvent::Ptr& event)
+{
+    /* estimated size of formatted components besides log message */
+    constexpr size_t kComponentsSize = 256;
+
+    /* if buffer is gonna full, flush it first, so that message is formatted in place without reallocation */
+    if (!buffer_.empty()
+        && buffer_.size() + event->getMsgView().size() + kComponentsSize > buffer_capacity_)
+        flushToBuffer();
+
+    formatMsgTo(buffer_, formatter, event);
 
-    /* if buffer is gonna full, flush it */
-    if (buffer_.size() + log_msg_size > buffer_.capacity())
+    /* write through if buffer is disabled or messages are larger than the whole buffer */
+    if (buffer_.size() >= buffer_capacity_)
         flushToBuffer();
+}
+
+void FileAppender::writeFormatted(std::string_view bytes)
+{
+    writeFormattedBatch({ &bytes, 1 });
+}
+
+void FileAppender::writeFormattedBatch(std::span<const std::string_view> buffers)
+{
+    size_t total_size = 0;
+    for (const auto& bytes: buffers)
+    {
+        total_size += bytes.size();
+    }
 
-    /* if not, just append to buffer */
-    buffer_.append(log_msg);
+    std::lock_guard<std::mutex> app_lk(app_mtx_);
+    /* mapping costs NO syscall, so copy buffers into it directly, unless I/O thread writes them */
+    if (is_async_.load(std::memory_order_relaxed)
+        || (backend_ != ioBackend::MMAP && buffer_.size() + total_size < buffer_capacity_))
+    {
+        for (const auto& bytes: buffers)
+        {
+            buffer_.append(bytes);
+        }
+        if (buffer_.size() >= buffer_capacity_)
+            flushToBuffer();
+        return;
+    }
+
+    /* buffer is gonna full, so gather it with the incoming buffers instead of copying them */
+    pieces_.clear();
+    if (!buffer_.empty())
+        pieces_.emplace_back(buffer_);
+    pieces_.insert(pieces_.end(), buffers.begin(), buffers.end());
+    {
+        std::lock_guard<std::mutex> io_lk(io_mtx_);
+        writePieces(pieces_);
+    }
+    buffer_.clear();
 }
 
 inline void FileAppender::flush()
 {
     std::lock_guard<std::mutex> app_lk(app_mtx_);
     flushToBuffer();
+    drainFlush();
+    drainRotation();
 
+    /* file descriptor and mapping have NO user space buffer, written range of mapping is scheduled to disk */
+    std::lock_guard<std::mutex> io_lk(io_mtx_);
+    if (backend_ == ioBackend::MMAP)
+        syncMapping();
     if (file_stream_.is_open())
         file_stream_.flush();
 }
@@ -159,6 +300,9 @@ inline void FileAppender::reopen(bool is_trunc)
 {
     std::lock_guard<std::mutex> app_lk(app_mtx_);
     flushToBuffer();
+    drainFlush();
+
+    std::lock_guard<std::mutex> io_lk(io_mtx_);
     open(is_trunc);
 
     if (!is_trunc && std::filesystem::exists(file_path_))
@@ -171,59 +315,765 @@ inline void FileAppender::flushToBuffer()
     if (buffer_.empty())
         return;
 
-    if (!file_stream_.is_open())
-        open(false);
+    /* I/O thread writes it, so that appending does NOT wait for disk */
+    if (is_async_.load(std::memory_order_relaxed))
+    {
+        sealBuffer();
+        return;
+    }
 
-    /* write into file and record file size */
-    file_stream_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
-    if (!file_stream_.good())
-        throw aw_logger::aw_logger_exception("failed to write to file: " + file_path_.string());
-    file_size_ += buffer_.size();
+    {
+        std::lock_guard<std::mutex> io_lk(io_mtx_);
+        const std::string_view bytes(buffer_);
+        writePieces({ &bytes, 1 });
+    }
 
     /* clear buffer */
     buffer_.clear();
+}
+
+inline void FileAppender::setAsyncFlush(bool enable, size_t buffer_num)
+{
+    if (enable && buffer_num < 2)
+        throw aw_logger::invalid_parameter("asynchronous flush needs at least 2 buffers!");
+
+    std::lock_guard<std::mutex> app_lk(app_mtx_);
+    flushToBuffer();
+    stopAsyncFlush();
+    if (!enable)
+        return;
+
+    /* the active buffer is `buffer_`, and the others are free at first */
+    for (size_t i = 1; i < buffer_num; i++)
+    {
+        std::string buffer;
+        buffer.reserve(buffer_capacity_);
+        free_buffers_.emplace_back(std::move(buffer));
+    }
+    is_stopping_ = false;
+    is_async_.store(true, std::memory_order_release);
+    flush_thread_ = std::thread([this]() { flushLoop(); });
+}
+
+inline void FileAppender::sealBuffer()
+{
+    std::unique_lock<std::mutex> flush_lk(flush_mtx_);
+    /* backpressure: wait until one of the in-flight buffers is written */
+    free_cv_.wait(flush_lk, [this]() { return !free_buffers_.empty(); });
+
+    /* swap is a pointer exchange, and the full buffer moves into queue without copying */
+    std::swap(buffer_, free_buffers_.back());
+    sealed_buffers_.emplace_back(std::move(free_buffers_.back()));
+    free_buffers_.pop_back();
+    flush_lk.unlock();
+    flush_cv_.notify_one();
+}
+
+inline void FileAppender::drainFlush()
+{
+    std::unique_lock<std::mutex> flush_lk(flush_mtx_);
+    free_cv_.wait(flush_lk, [this]() { return sealed_buffers_.empty() && !is_writing_; });
+}
+
+inline void FileAppender::stopAsyncFlush()
+{
+    if (!flush_thread_.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> flush_lk(flush_mtx_);
+        is_stopping_ = true;
+    }
+    flush_cv_.notify_all();
+    flush_thread_.join();
+
+    is_async_.store(false, std::memory_order_release);
+    free_buffers_.clear();
+}
+
+inline void FileAppender::flushLoop()
+{
+    /* sealed buffers taken at once, and views of them */
+    std::vector<std::string> buffers;
+    std::vector<std::string_view> views;
+
+    std::unique_lock<std::mutex> flush_lk(flush_mtx_);
+    while (true)
+    {
+        flush_cv_.wait(flush_lk, [this]() { return is_stopping_ || !sealed_buffers_.empty(); });
+
+        /* sealed buffers are written before I/O thread stops */
+        if (sealed_buffers_.empty())
+            return;
+
+        /* take all the sealed buffers, so that they are gathered or in flight together */
+        while (!sealed_buffers_.empty())
+        {
+            buffers.emplace_back(std::move(sealed_buffers_.front()));
+            sealed_buffers_.pop_front();
+        }
+        is_writing_ = true;
+        flush_lk.unlock();
+
+        views.assign(buffers.begin(), buffers.end());
+        try
+        {
+            std::lock_guard<std::mutex> io_lk(io_mtx_);
+            writePieces(views);
+        } catch (const std::exception& ex)
+        {
+            std::cerr << ex.what() << '\n' << std::endl;
+        } catch (...)
+        {
+            std::cerr << "unknown exception in file appender I/O thread.\n" << std::endl;
+        }
+
+        flush_lk.lock();
+        is_writing_ = false;
+        for (auto& buffer: buffers)
+        {
+            buffer.clear();
+            free_buffers_.emplace_back(std::move(buffer));
+        }
+        buffers.clear();
+        free_cv_.notify_all();
+    }
+}
+
+inline void FileAppender::writePieces(std::span<const std::string_view> pieces)
+{
+    if (!isOpen())
+        open(false);
+
+    /* bytes written before a failure are accounted, so that positioned writes of the next call do NOT overwrite them */
+    size_t written_size = 0;
+    try
+    {
+        writeBackend(pieces, written_size);
+    } catch (...)
+    {
+        file_size_ += written_size;
+        throw;
+    }
+
+    /* record file size */
+    file_size_ += written_size;
 
     /* check if file needs rotated to new log file */
-    if (max_file_size_ > 0 && file_size_ >= max_file_size_)
+    const size_t max_file_size = max_file_size_.load(std::memory_order_relaxed);
+    if (max_file_size > 0 && file_size_ >= max_file_size)
         rotateFile();
 }
 
+inline void FileAppender::writeBackend(std::span<const std::string_view> pieces, size_t& written_size)
+{
+    if (backend_ == ioBackend::MMAP)
+    {
+        copyToMapping(pieces, written_size);
+    }
+    else if (backend_ == ioBackend::URING)
+    {
+        submitToRing(pieces, written_size);
+    }
+    else if (backend_ == ioBackend::POSIX)
+    {
+#if AW_LOGGER_HAS_POSIX_IO
+        /* max number of pieces of ONE writev(), far below IOV_MAX */
+        constexpr size_t kMaxIovNum = 64;
+        std::array<iovec, kMaxIovNum> iov;
+
+        /* index of the first piece NOT written yet, and bytes of it written by a partial write */
+        size_t index = 0;
+        size_t offset = 0;
+        while (index < pieces.size())
+        {
+            size_t iov_num = 0;
+            for (size_t i = index; i < pieces.size() && iov_num < kMaxIovNum; i++)
+            {
+                const size_t skip = (i == index) ? offset : 0;
+                if (pieces[i].size() == skip)
+                    continue;
+
+                iov[iov_num].iov_base = const_cast<char*>(pieces[i].data() + skip);
+                iov[iov_num].iov_len = pieces[i].size() - skip;
+                iov_num++;
+            }
+            if (iov_num == 0)
+                break;
+
+            const auto ret = (iov_num == 1) ? ::write(fd_, iov[0].iov_base, iov[0].iov_len)
+                                            : ::writev(fd_, iov.data(), static_cast<int>(iov_num));
+            if (ret < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw aw_logger::aw_logger_exception(
+                    "failed to write to file: " + file_path_.string() + ", " + std::strerror(errno)
+                );
+            }
+            /* NO progress of non-empty write, retrying would loop forever */
+            if (ret == 0)
+                throw aw_logger::aw_logger_exception(
+                    "failed to write to file: " + file_path_.string() + ", no bytes written"
+                );
+            written_size += static_cast<size_t>(ret);
+
+            /* skip pieces which are written completely, partial write resumes from offset */
+            auto left = static_cast<size_t>(ret);
+            while (index < pieces.size() && left >= pieces[index].size() - offset)
+            {
+                left -= pieces[index].size() - offset;
+                offset = 0;
+                index++;
+            }
+            offset += left;
+        }
+
+        if (is_durable_.load(std::memory_order_relaxed) && written_size > 0)
+            syncData();
+#endif
+    }
+    else
+    {
+        for (const auto& bytes: pieces)
+        {
+            file_stream_.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            written_size += bytes.size();
+        }
+        if (!file_stream_.good())
+            throw aw_logger::aw_logger_exception("failed to write to file: " + file_path_.string());
+    }
+}
+
+inline void FileAppender::copyToMapping(std::span<const std::string_view> pieces, size_t& written_size)
+{
+#if AW_LOGGER_HAS_POSIX_IO
+    for (const auto& bytes: pieces)
+    {
+        size_t copied = 0;
+        while (copied < bytes.size())
+        {
+            const size_t offset = file_size_ + written_size;
+            if (map_ == nullptr || offset >= map_begin_ + map_size_)
+                mapSegment(offset);
+
+            const size_t size = std::min(bytes.size() - copied, map_begin_ + map_size_ - offset);
+            std::memcpy(map_ + (offset - map_begin_), bytes.data() + copied, size);
+            copied += size;
+            written_size += size;
+        }
+    }
+#else
+    static_cast<void>(pieces);
+    static_cast<void>(written_size);
+#endif
+}
+
+inline void FileAppender::submitToRing(std::span<const std::string_view> pieces, size_t& written_size)
+{
+#if AW_LOGGER_HAS_IO_URING
+    /* user data of fsync, and writes take their ordinal inside batch */
+    constexpr uint64_t kFsyncData = UINT64_MAX;
+    /* ONE entry is left for fsync */
+    constexpr size_t kMaxWriteNum = IoUring::kDefaultEntries - 1;
+    /* index of piece and result of each write inside batch, empty pieces are NOT submitted */
+    std::array<size_t, kMaxWriteNum> indices;
+    std::array<int, kMaxWriteNum> results;
+
+    const bool is_durable = is_durable_.load(std::memory_order_relaxed);
+    const size_t batch_num = std::min<size_t>(ring_->getEntries() - 1, kMaxWriteNum);
+    size_t index = 0;
+    while (index < pieces.size())
+    {
+        /* writes of ONE batch are in flight together at their own offsets */
+        uint64_t offset = file_size_ + written_size;
+        unsigned request_num = 0;
+        for (; index < pieces.size() && request_num < batch_num; index++)
+        {
+            if (pieces[index].empty())
+                continue;
+
+            /* size of ONE request is 32-bit, the rest of a larger piece is finished as a short write */
+            const auto size =
+                static_cast<unsigned>(std::min<size_t>(pieces[index].size(), std::numeric_limits<unsigned>::max()));
+            ring_->prepareWrite(fd_, pieces[index].data(), size, offset, request_num);
+            indices[request_num] = index;
+            offset += pieces[index].size();
+            request_num++;
+        }
+        if (request_num == 0)
+            break;
+        const unsigned write_num = request_num;
+        if (is_durable)
+        {
+            ring_->prepareFsync(fd_, kFsyncData);
+            request_num++;
+        }
+
+        int fsync_result = 0;
+        ring_->submitAndWait(request_num, [&](uint64_t user_data, int result) {
+            if (user_data == kFsyncData)
+                fsync_result = result;
+            else
+                results[user_data] = result;
+        });
+
+        /* finish short writes by plain write path, and account pieces in order as they are completed */
+        bool has_short_write = false;
+        for (unsigned i = 0; i < write_num; i++)
+        {
+            const auto& bytes = pieces[indices[i]];
+            if (results[i] < 0)
+                throw aw_logger::aw_logger_exception(
+                    "failed to write to file: " + file_path_.string() + ", " + std::strerror(-results[i])
+                );
+
+            offset = file_size_ + written_size;
+            for (auto done = static_cast<size_t>(results[i]); done < bytes.size();)
+            {
+                has_short_write = true;
+                const auto ret = ::pwrite(
+                    fd_,
+                    bytes.data() + done,
+                    bytes.size() - done,
+                    static_cast<off_t>(offset + done)
+                );
+                if (ret < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    written_size += done;
+                    throw aw_logger::aw_logger_exception(
+                        "failed to write to file: " + file_path_.string() + ", " + std::strerror(errno)
+                    );
+                }
+                done += static_cast<size_t>(ret);
+            }
+            written_size += bytes.size();
+        }
+
+        if (fsync_result < 0)
+            throw aw_logger::aw_logger_exception(
+                "failed to sync file: " + file_path_.string() + ", " + std::strerror(-fsync_result)
+            );
+        if (is_durable && has_short_write)
+            syncData();
+    }
+#else
+    static_cast<void>(pieces);
+    static_cast<void>(written_size);
+#endif
+}
+
+inline void FileAppender::syncData()
+{
+#if AW_LOGGER_HAS_POSIX_IO
+    #ifdef __linux__
+    const int ret = ::fdatasync(fd_);
+    #else
+    const int ret = ::fsync(fd_);
+    #endif
+    if (ret != 0)
+        throw aw_logger::aw_logger_exception(
+            "failed to sync file: " + file_path_.string() + ", " + std::strerror(errno)
+        );
+#endif
+}
+
+inline void FileAppender::mapSegment(size_t offset)
+{
+#if AW_LOGGER_HAS_POSIX_IO
+    unmapSegment();
+
+    /* segment begins at page of offset, and does NOT go far beyond max file size */
+    const auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const auto round_up = [page_size](size_t size) {
+        return (std::max<size_t>(size, 1) + page_size - 1) / page_size * page_size;
+    };
+    size_t segment_size = round_up(segment_size_.load(std::memory_order_relaxed));
+    const size_t max_file_size = max_file_size_.load(std::memory_order_relaxed);
+    if (max_file_size > 0)
+        segment_size = std::min(segment_size, round_up(max_file_size));
+
+    const size_t begin = offset / page_size * page_size;
+
+    /* preallocate disk blocks, so that writing to mapping does NOT raise SIGBUS once disk is full */
+    #ifdef __linux__
+    const int ret =
+        ::posix_fallocate(fd_, static_cast<off_t>(begin), static_cast<off_t>(segment_size));
+    #else
+    const int ret = ::ftruncate(fd_, static_cast<off_t>(begin + segment_size)) == 0 ? 0 : errno;
+    #endif
+    if (ret != 0)
+        throw aw_logger::aw_logger_exception(
+            "failed to preallocate file: " + file_path_.string() + ", " + std::strerror(ret)
+        );
+
+    void* addr =
+        ::mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, static_cast<off_t>(begin));
+    if (addr == MAP_FAILED)
+        throw aw_logger::aw_logger_exception(
+            "failed to map file: " + file_path_.string() + ", " + std::strerror(errno)
+        );
+
+    map_ = static_cast<char*>(addr);
+    map_begin_ = begin;
+    map_size_ = segment_size;
+#endif
+}
+
+inline void FileAppender::unmapSegment() noexcept
+{
+#if AW_LOGGER_HAS_POSIX_IO
+    if (map_ != nullptr)
+    {
+        ::munmap(map_, map_size_);
+        map_ = nullptr;
+        map_size_ = 0;
+    }
+#endif
+}
+
+inline void FileAppender::syncMapping()
+{
+#if AW_LOGGER_HAS_POSIX_IO
+    if (map_ == nullptr || file_size_ <= map_begin_)
+        return;
+
+    const size_t size = std::min(file_size_ - map_begin_, map_size_);
+    if (::msync(map_, size, MS_ASYNC) != 0)
+        throw aw_logger::aw_logger_exception(
+            "failed to sync mapping: " + file_path_.string() + ", " + std::strerror(errno)
+        );
+#endif
+}
+
+inline void FileAppender::trimZeroTail()
+{
+#if AW_LOGGER_HAS_POSIX_IO
+    const auto end = ::lseek(fd_, 0, SEEK_END);
+    if (end < 0)
+        throw aw_logger::aw_logger_exception(
+            "can not get size of file: " + file_path_.string() + ", " + std::strerror(errno)
+        );
+
+    /* scan backwards chunk by chunk until a non-zero byte, log text has NO zero byte */
+    std::array<char, 4096> chunk;
+    auto size = static_cast<size_t>(end);
+    while (size > 0)
+    {
+        const size_t read_size = std::min(size, chunk.size());
+        const auto ret = ::pread(fd_, chunk.data(), read_size, static_cast<off_t>(size - read_size));
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw aw_logger::aw_logger_exception(
+                "failed to read file: " + file_path_.string() + ", " + std::strerror(errno)
+            );
+        }
+
+        /* file is NOT expected to shrink while it's opened, keep the rest as it is */
+        if (static_cast<size_t>(ret) < read_size)
+            break;
+
+        size_t tail = read_size;
+        while (tail > 0 && chunk[tail - 1] == '\0')
+        {
+            tail--;
+        }
+        size -= read_size - tail;
+        if (tail > 0)
+            break;
+    }
+
+    if (size < static_cast<size_t>(end) && ::ftruncate(fd_, static_cast<off_t>(size)) != 0)
+        throw aw_logger::aw_logger_exception(
+            "failed to truncate file: " + file_path_.string() + ", " + std::strerror(errno)
+        );
+    file_size_ = size;
+#endif
+}
+
 inline void FileAppender::rotateFile()
 {
-    /* flush and close current file stream */
-    file_stream_.flush();
-    file_stream_.close();
+    retired_file_t retired;
+    retired.path_ = createRotationPath("retired" + std::to_string(++retired_seq_));
+    retired.size_ = file_size_;
+#if AW_LOGGER_HAS_POSIX_IO
+    /* closing a file just written may start its writeback, so rotation thread closes it after rename */
+    unmapSegment();
+    retired.fd_ = fd_;
+    fd_ = -1;
+    retired.stream_.swap(file_stream_);
+#else
+    /* file can NOT be renamed while it's opened */
+    close();
+#endif
+
+    /* retire current file by ONE rename, and its backup is shuffled by rotation thread later */
+    std::error_code ec;
+    std::filesystem::rename(file_path_, retired.path_, ec);
+    const auto rename_ec = ec;
+    const bool is_moved = !ec || ec == std::errc::no_such_file_or_directory;
+    if (ec)
+        retired.path_.clear();
+
+    bool is_switched = false;
+    {
+        std::lock_guard<std::mutex> rotate_lk(rotate_mtx_);
+        retired_files_.emplace_back(std::move(retired));
+
+        /* next file takes place under lock, so that rotation thread does NOT pre-open another one at its path */
+        if (has_next_ && is_moved)
+        {
+            has_next_ = false;
+            std::filesystem::rename(createRotationPath("next"), file_path_, ec);
+            if (backend_ == ioBackend::STREAM)
+            {
+                if (!ec)
+                    file_stream_.swap(next_stream_);
+                else
+                    next_stream_.close();
+            }
+            else
+            {
+#if AW_LOGGER_HAS_POSIX_IO
+                if (!ec)
+                    fd_ = next_fd_;
+                else
+                    ::close(next_fd_);
+#endif
+                next_fd_ = -1;
+            }
+            is_switched = !ec;
+        }
+
+        if (!rotate_thread_.joinable())
+        {
+            is_rotate_stopping_ = false;
+            rotate_thread_ = std::thread([this]() { rotateLoop(); });
+        }
+    }
+    rotate_cv_.notify_all();
+
+    /* file is reopened by the next write if it's NOT renamed */
+    if (!is_moved)
+        throw aw_logger::aw_logger_exception(
+            "can not rotate file: " + file_path_.string() + ", " + rename_ec.message()
+        );
+
+    /* reset file size, and open new file in truncate mode if rotation thread is behind */
+    file_size_ = 0;
+    if (!is_switched)
+        open(true);
+}
+
+inline void FileAppender::openNext()
+{
+    const auto next_path = createRotationPath("next");
+    if (backend_ == ioBackend::STREAM)
+    {
+        std::ofstream stream(next_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!stream.is_open())
+            throw aw_logger::aw_logger_exception("can not open file: " + next_path.string());
+
+        std::lock_guard<std::mutex> rotate_lk(rotate_mtx_);
+        next_stream_ = std::move(stream);
+        has_next_ = true;
+        return;
+    }
+
+#if AW_LOGGER_HAS_POSIX_IO
+    /* same flags as `open()` in truncate mode */
+    const int flags = O_CREAT | O_CLOEXEC | O_TRUNC | (backend_ == ioBackend::MMAP ? O_RDWR : O_WRONLY)
+        | (backend_ == ioBackend::POSIX ? O_APPEND : 0);
+    const int fd = ::open(next_path.c_str(), flags, 0644);
+    if (fd < 0)
+        throw aw_logger::aw_logger_exception(
+            "can not open file: " + next_path.string() + ", " + std::strerror(errno)
+        );
+
+    std::lock_guard<std::mutex> rotate_lk(rotate_mtx_);
+    next_fd_ = fd;
+    has_next_ = true;
+#endif
+}
+
+inline void FileAppender::retireFile(retired_file_t& retired)
+{
+#if AW_LOGGER_HAS_POSIX_IO
+    if (retired.fd_ >= 0)
+    {
+        /* cut zero-filled tail of preallocated segment */
+        if (backend_ == ioBackend::MMAP)
+            static_cast<void>(::ftruncate(retired.fd_, static_cast<off_t>(retired.size_)));
+        ::close(retired.fd_);
+        retired.fd_ = -1;
+    }
+#endif
+    if (retired.stream_.is_open())
+        retired.stream_.close();
+
+    /* retired file is NOT renamed if it's removed by others */
+    if (retired.path_.empty())
+        return;
+
+    const size_t backup_num = max_backup_num_.load(std::memory_order_relaxed);
 
     /* rotate backup files: filename_backupN.ext -> filename_backup(N+1).ext */
-    if (max_backup_num_ > 0)
+    if (backup_num > 0)
     {
         /* delete oldest backup if exists */
-        std::filesystem::path oldest_backup = createBackupPath(max_backup_num_);
+        std::filesystem::path oldest_backup = createBackupPath(backup_num);
         if (std::filesystem::exists(oldest_backup))
             std::filesystem::remove(oldest_backup);
 
         /* rename existing backups: backup(N-1) -> backupN in the loop */
-        for (size_t i = max_backup_num_; i > 1; i--)
+        for (size_t i = backup_num; i > 1; i--)
         {
             const auto src = createBackupPath(i - 1);
             if (std::filesystem::exists(src))
                 std::filesystem::rename(src, createBackupPath(i));
         }
 
-        /* rename current file to the first backup */
-        if (std::filesystem::exists(file_path_))
-            std::filesystem::rename(file_path_, createBackupPath(1));
+        /* rename retired file to the first backup */
+        std::filesystem::rename(retired.path_, createBackupPath(1));
     }
-    else if (std::filesystem::exists(file_path_))
+    else
     {
-        /* if no backup limit, just remove current file */
-        std::filesystem::remove(file_path_);
+        /* if no backup limit, just remove retired file */
+        std::filesystem::remove(retired.path_);
     }
+}
 
-    /* reset file size and open new file */
-    file_size_ = 0;
-    /* open in truncate mode for clear new file first */
-    open(true);
+inline void FileAppender::drainRotation()
+{
+    std::unique_lock<std::mutex> rotate_lk(rotate_mtx_);
+    rotate_cv_.wait(rotate_lk, [this]() { return retired_files_.empty(); });
+}
+
+inline void FileAppender::stopRotation()
+{
+    if (!rotate_thread_.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> rotate_lk(rotate_mtx_);
+        is_rotate_stopping_ = true;
+    }
+    rotate_cv_.notify_all();
+    rotate_thread_.join();
+
+    /* the next file is NOT used anymore */
+    if (has_next_)
+    {
+        has_next_ = false;
+        if (next_stream_.is_open())
+            next_stream_.close();
+#if AW_LOGGER_HAS_POSIX_IO
+        if (next_fd_ >= 0)
+            ::close(next_fd_);
+#endif
+        next_fd_ = -1;
+        std::error_code ec;
+        std::filesystem::remove(createRotationPath("next"), ec);
+    }
+}
+
+inline void FileAppender::rotateLoop()
+{
+#if AW_LOGGER_HAS_POSIX_IO && defined(SCHED_BATCH)
+    /* rotation thread is housekeeping, so it does NOT preempt writing thread once it's woken up */
+    sched_param param {};
+    static_cast<void>(::pthread_setschedparam(::pthread_self(), SCHED_BATCH, &param));
+#endif
+
+    std::unique_lock<std::mutex> rotate_lk(rotate_mtx_);
+    while (true)
+    {
+        rotate_cv_.wait(rotate_lk, [this]() { return is_rotate_stopping_ || !retired_files_.empty(); });
+
+        /* retired files are shuffled before rotation thread stops */
+        if (retired_files_.empty())
+            return;
+
+        /**
+         * the next file is pre-opened before shuffling, so that the coming rotation does NOT open it.
+         * it's skipped where opened file can NOT be renamed
+         */
+#if AW_LOGGER_HAS_POSIX_IO
+        const bool needs_next = !has_next_ && !is_rotate_stopping_;
+#else
+        const bool needs_next = false;
+#endif
+        /* reference to the front one stays valid while others are pushed back */
+        auto& retired = retired_files_.front();
+        rotate_lk.unlock();
+        if (needs_next)
+        {
+            try
+            {
+                openNext();
+            } catch (const std::exception& ex)
+            {
+                std::cerr << ex.what() << '\n' << std::endl;
+            }
+        }
+        try
+        {
+            retireFile(retired);
+        } catch (const std::exception& ex)
+        {
+            std::cerr << ex.what() << '\n' << std::endl;
+        }
+        rotate_lk.lock();
+
+        retired_files_.pop_front();
+        rotate_cv_.notify_all();
+    }
+}
+
+inline void FileAppender::sweepRotation()
+{
+    std::error_code ec;
+    const auto dir = file_path_.parent_path().empty() ? std::filesystem::path(".") : file_path_.parent_path();
+    if (!std::filesystem::is_directory(dir, ec))
+        return;
+
+    /* the next file has NOT been written yet */
+    std::filesystem::remove(createRotationPath("next"), ec);
+
+    /* collect retired files by their sequence numbers: filename_retiredN.ext */
+    const auto prefix = file_path_.stem().string() + "_retired";
+    const auto extension = file_path_.extension().string();
+    std::vector<std::pair<size_t, std::filesystem::path>> leftovers;
+    for (const auto& entry: std::filesystem::directory_iterator(dir, ec))
+    {
+        const auto name = entry.path().filename().string();
+        if (name.size() <= prefix.size() + extension.size() || !name.starts_with(prefix) || !name.ends_with(extension))
+            continue;
+
+        const auto seq = name.substr(prefix.size(), name.size() - prefix.size() - extension.size());
+        if (!std::all_of(seq.begin(), seq.end(), [](char c) { return c >= '0' && c <= '9'; }))
+            continue;
+        leftovers.emplace_back(std::stoull(seq), entry.path());
+    }
+
+    /* the older one is retired first, so that the latest one becomes the first backup */
+    std::sort(leftovers.begin(), leftovers.end());
+    for (auto& [seq, path]: leftovers)
+    {
+        retired_file_t retired;
+        retired.path_ = std::move(path);
+        try
+        {
+            retireFile(retired);
+        } catch (const std::exception& ex)
+        {
+            std::cerr << ex.what() << '\n' << std::endl;
+        }
+    }
 }
 
 inline std::filesystem::path FileAppender::createBackupPath(size_t index) const noexcept
@@ -233,6 +1083,12 @@ inline std::filesystem::path FileAppender::createBackupPath(size_t index) const
            + file_path_.extension().string());
 }
 
+inline std::filesystem::path FileAppender::createRotationPath(std::string_view tag) const noexcept
+{
+    return file_path_.parent_path()
+        / (file_path_.stem().string() + "_" + std::string(tag) + file_path_.extension().string());
+}
+
 } // namespace aw_logger
 
 #endif //! IMPL__FILE_APPENDER_IMPL_HPP
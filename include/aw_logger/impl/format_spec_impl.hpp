@@ -0,0 +1,176 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMPL__FORMAT_SPEC_IMPL_HPP
+#define IMPL__FORMAT_SPEC_IMPL_HPP
+
+// C++ standard library
+#include <iterator>
+
+// aw_logger library
+#include "aw_logger/format_spec.hpp"
+
+namespace aw_logger {
+consteval FormatSpec::FormatSpec(std::string_view fmt): fmt_(fmt)
+{
+    /* offsets are stored in 16 bits */
+    if (fmt.size() > UINT16_MAX)
+        return;
+
+    size_t auto_id = 0;
+    bool auto_index = false;
+    bool manual_index = false;
+    size_t literal_begin = 0;
+    size_t i = 0;
+    while (i < fmt.size())
+    {
+        const char c = fmt[i];
+
+        /* escaped brace `{{` or `}}`, keep ONE brace in literal text */
+        if ((c == '{' || c == '}') && i + 1 < fmt.size() && fmt[i + 1] == c)
+        {
+            if (!addSegment(literal_begin, i + 1 - literal_begin, kLiteral))
+                return;
+            i += 2;
+            literal_begin = i;
+            continue;
+        }
+        if (c == '}')
+            return;
+        if (c != '{')
+        {
+            ++i;
+            continue;
+        }
+
+        /* replacement field like `{arg_id:spec}` */
+        if (i > literal_begin && !addSegment(literal_begin, i - literal_begin, kLiteral))
+            return;
+        ++i;
+
+        size_t arg_id = 0;
+        if (i < fmt.size() && fmt[i] >= '0' && fmt[i] <= '9')
+        {
+            manual_index = true;
+            while (i < fmt.size() && fmt[i] >= '0' && fmt[i] <= '9' && arg_id < kLiteral)
+            {
+                arg_id = arg_id * 10 + static_cast<size_t>(fmt[i] - '0');
+                ++i;
+            }
+        }
+        else
+        {
+            auto_index = true;
+            arg_id = auto_id++;
+        }
+        if ((auto_index && manual_index) || arg_id >= kLiteral)
+            return;
+
+        size_t spec_begin = i;
+        if (i < fmt.size() && fmt[i] == ':')
+        {
+            spec_begin = ++i;
+            while (i < fmt.size() && fmt[i] != '}')
+            {
+                /* nested replacement field, e.g. dynamic width */
+                if (fmt[i] == '{')
+                    return;
+                ++i;
+            }
+        }
+        if (i >= fmt.size() || fmt[i] != '}')
+            return;
+        if (!addSegment(spec_begin, i - spec_begin, static_cast<uint8_t>(arg_id)))
+            return;
+        ++i;
+        literal_begin = i;
+    }
+
+    if (fmt.size() > literal_begin && !addSegment(literal_begin, fmt.size() - literal_begin, kLiteral))
+        return;
+    parsed_ = true;
+}
+
+constexpr bool FormatSpec::addSegment(size_t begin, size_t size, uint8_t arg_id) noexcept
+{
+    if (size_ == kMaxSegments)
+        return false;
+
+    segments_[size_++] =
+        segment_t { static_cast<uint16_t>(begin), static_cast<uint16_t>(size), arg_id };
+    return true;
+}
+
+template<typename... Args>
+void FormatSpec::formatTo(std::string& out, const Args&... args) const
+{
+    if (!parsed_)
+    {
+        std::vformat_to(std::back_inserter(out), fmt_, std::make_format_args(args...));
+        return;
+    }
+
+    for (size_t i = 0; i < size_; i++)
+    {
+        const auto& segment = segments_[i];
+        const auto text = fmt_.substr(segment.begin_, segment.size_);
+        if (segment.arg_id_ == kLiteral)
+        {
+            out.append(text);
+            continue;
+        }
+
+        /* pick the argument by index */
+        [[maybe_unused]] size_t idx = 0;
+        ((idx++ == segment.arg_id_ ? formatArg(out, text, args) : void()), ...);
+    }
+}
+
+template<typename T>
+void FormatSpec::formatArg(std::string& out, std::string_view spec, const T& arg)
+{
+    if (spec.empty())
+    {
+        std::format_to(std::back_inserter(out), "{}", arg);
+        return;
+    }
+
+    /* spec is NOT parsed again, the formatter which has parsed it formats the argument */
+    std::format_to(std::back_inserter(out), "{}", parsed_arg_t<T> { arg, &getFormatter<T>(spec) });
+}
+
+template<typename T>
+std::formatter<T, char>& FormatSpec::getFormatter(std::string_view spec)
+{
+    /**
+     * spec lives inside format string with static storage duration, so its address identifies the field,
+     * and each thread keeps its own formatters without lock
+     */
+    thread_local std::unordered_map<const char*, std::formatter<T, char>> formatters;
+    const auto it = formatters.find(spec.data());
+    if (it != formatters.end())
+        return it->second;
+
+    /* parse range ends with the closing brace which follows spec */
+    std::formatter<T, char> formatter;
+    std::format_parse_context parse_ctx(std::string_view(spec.data(), spec.size() + 1));
+    const auto parse_end = formatter.parse(parse_ctx);
+    if (parse_end == parse_ctx.end() || *parse_end != '}')
+        throw std::format_error("invalid format spec: " + std::string(spec));
+
+    return formatters.emplace(spec.data(), formatter).first->second;
+}
+} // namespace aw_logger
+
+#endif //! IMPL__FORMAT_SPEC_IMPL_HPP
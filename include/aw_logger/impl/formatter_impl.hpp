@@ -16,8 +16,11 @@
 #define IMPL__FORMATTER_IMPL_HPP
 
 // C++ standard library
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <fstream>
+#include <iterator>
 
 // aw_logger library
 #include "aw_logger/exception.hpp"
@@ -62,149 +65,589 @@ inline void ComponentFactory::registerComponents(const nlohmann::json& json)
         if (component["enabled"].get<bool>())
         {
             const auto& type = component["type"];
+            const auto spec = parseComponentSpec(component);
             /* color */
             if (type == "color")
-                registered_components_.push_back({ "color", component["level_colors"].dump() });
+            {
+                registerComponent("color", component["level_colors"].dump(), {});
+                resolveLevelColors(component["level_colors"]);
+            }
 
             /* timestamp */
             else if (type == "timestamp")
-                registered_components_.push_back({ "timestamp", "" });
+            {
+                const auto precision = component.value("precision", "ns");
+                if (precision != "ms" && precision != "us" && precision != "ns")
+                    throw aw_logger::invalid_parameter(
+                        std::string("invalid timestamp precision: ") + precision
+                    );
+                registerComponent("timestamp", precision, spec);
+            }
 
             /* level */
             else if (type == "level")
-                registered_components_.push_back({ "level", "" });
+                registerComponent("level", "", spec);
 
             /* thread id */
             else if (type == "tid")
-                registered_components_.push_back({ "tid", "" });
+                registerComponent("tid", "", spec);
 
             /* source location */
             else if (type == "loc")
-                registered_components_.push_back({ "loc", component.value("format", "") });
+                registerComponent("loc", component.value("format", ""), spec);
 
             /* message */
             else if (type == "msg")
-                registered_components_.push_back({ "msg", "" });
+                registerComponent("msg", "", spec);
+
+            /* logger name */
+            else if (type == "logger")
+                registerComponent("logger", "", spec);
+
+            /* elapsed time */
+            else if (type == "elapsed")
+                registerComponent("elapsed", "", spec);
+
+            /* thread name */
+            else if (type == "thread_name")
+                registerComponent("thread_name", "", spec);
         }
     }
 }
 
+inline void
+ComponentFactory::registerComponent(std::string_view type, std::string_view format, component_spec_t spec)
+{
+    registered_components_.emplace_back(std::string(type), std::string(format));
+    registered_specs_.push_back(spec);
+}
+
+inline ComponentFactory::component_spec_t
+ComponentFactory::parseComponentSpec(const nlohmann::json& component)
+{
+    component_spec_t spec;
+    spec.min_width_ = component.value("width", uint16_t { 0 });
+    spec.max_width_ = component.value("max_width", uint16_t { 0 });
+
+    const auto align = component.value("align", "right");
+    if (align == "left")
+        spec.align_ = alignType::LEFT;
+    else if (align == "center")
+        spec.align_ = alignType::CENTER;
+    else if (align != "right")
+        throw aw_logger::invalid_parameter(std::string("invalid component align: ") + align);
+    return spec;
+}
+
 void ComponentFactory::parsePattern(std::string_view pattern)
 {
-    /* initialize state, left position and right position */
-    /* vector of {type, unformatted data} */
-    std::vector<std::pair<std::string, std::string>> pattern_components;
-    const size_t size = pattern.size();
-    patternState state = patternState::NORMAL_TEXT;
-    size_t lpos = 0, rpos = 0;
-
-    /* parse loop until EOL: '\0' */
-    while (rpos <= size)
+    registered_components_.clear();
+    registered_specs_.clear();
+
+    /* literal text is accumulated until the next component, so `%%` doesn't split it */
+    std::string text;
+    const auto flush_text = [this, &text]() {
+        if (!text.empty())
+        {
+            registerComponent("text", text, {});
+            text.clear();
+        }
+    };
+
+    /* parse a decimal number at `pos`, e.g. width of `%-12p` */
+    const auto parse_number = [&pattern](size_t& pos) -> uint16_t {
+        size_t number = 0;
+        while (pos < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[pos])))
+            number = std::min<size_t>(number * 10 + static_cast<size_t>(pattern[pos++] - '0'), UINT16_MAX);
+        return static_cast<uint16_t>(number);
+    };
+
+    size_t pos = 0;
+    while (pos < pattern.size())
     {
-        /* current char to judge whether '%' or EOL */
-        auto curr_char = (rpos < size) ? pattern[rpos] : '\0';
-        switch (state)
+        const auto percent = pattern.find('%', pos);
+        text.append(pattern.substr(pos, percent - pos));
+        if (percent == std::string_view::npos)
+            break;
+
+        /* `%[align][min_width][.max_width]conversion` */
+        pos = percent + 1;
+        component_spec_t spec;
+        if (pos < pattern.size() && (pattern[pos] == '-' || pattern[pos] == '='))
+            spec.align_ = pattern[pos++] == '-' ? alignType::LEFT : alignType::CENTER;
+        spec.min_width_ = parse_number(pos);
+
+        bool has_precision = false;
+        uint16_t precision = 0;
+        if (pos < pattern.size() && pattern[pos] == '.')
         {
-            /* emplace normal text directly */
-            case patternState::NORMAL_TEXT:
-                /* if current char is '%' or EOL, emplace text to break or ready for parse pattern char */
-                if (curr_char == '%' || curr_char == '\0')
-                {
-                    /**
-                     * emplace back text between lpos and rpos which means char before '%'
-                     * e.g.:
-                     * - in case of '%', "abc%t", it emplace back "abc"
-                     * - in case of EOL, "abcefgdasd\0", it emplace back "abcefgdasd"
-                     */
-                    if (lpos < rpos)
-                        pattern_components.emplace_back(
-                            "s",
-                            std::string(pattern.substr(lpos, rpos - lpos))
-                        );
-
-                    if (curr_char == '%')
-                    {
-                        /**
-                         * move `lpos` to next char of '%' for parsing pattern char
-                         * e.g. `lpos` move to 't' of '%t'
-                         */
-                        lpos = rpos + 1;
-                        /* switch state to parse pattern char */
-                        state = patternState::PATTERN_CHAR;
-                    }
-                }
-                break;
+            pos++;
+            has_precision = true;
+            precision = parse_number(pos);
+        }
 
-            /* parse pattern char */
-            case patternState::PATTERN_CHAR:
-                /* if current char is not alphabet or it's an EOL, break and switch to normal text */
-                if (!std::isalpha(static_cast<unsigned char>(curr_char)))
-                {
-                    /* emplace pattern char if exists */
-                    if (lpos < rpos)
-                        pattern_components.emplace_back(
-                            std::string(pattern.substr(lpos, rpos - lpos)),
-                            ""
-                        );
-
-                    /* switch state to normal text parsing */
-                    state = patternState::NORMAL_TEXT;
-                    /* move `lpos` to current position for next normal text emplacing */
-                    lpos = rpos;
-                    continue;
-                }
+        /* dangling specifier at the end is kept as text */
+        if (pos >= pattern.size())
+        {
+            text.append(pattern.substr(percent));
+            break;
+        }
+
+        const char conversion = pattern[pos++];
+        if (conversion == '%')
+        {
+            text += '%';
+            continue;
+        }
+
+        /* precision of timestamp is number of sub-second digits, otherwise it's max width */
+        std::string format;
+        if (conversion == 't' && has_precision)
+        {
+            if (precision == 3)
+                format = "ms";
+            else if (precision == 6)
+                format = "us";
+            else if (precision == 9)
+                format = "ns";
+            else
+                throw aw_logger::invalid_parameter(
+                    std::string("invalid timestamp precision in pattern: ") + std::to_string(precision)
+                );
+        }
+        else if (has_precision)
+            spec.max_width_ = precision;
+
+        const char* type = nullptr;
+        switch (conversion)
+        {
+            /* timestamp */
+            case 't':
+                type = "timestamp";
                 break;
+            /* level */
+            case 'p':
+                type = "level";
+                break;
+            /* thread id */
+            case 'i':
+                type = "tid";
+                break;
+            /* file name, function name and line */
+            case 'f':
+                type = "loc";
+                format = "{file_name}";
+                break;
+            case 'n':
+                type = "loc";
+                format = "{function_name}";
+                break;
+            case 'l':
+                type = "loc";
+                format = "{line}";
+                break;
+            /* log message */
+            case 'm':
+                type = "msg";
+                break;
+            /* logger name */
+            case 'c':
+                type = "logger";
+                break;
+            /* elapsed time */
+            case 'r':
+                type = "elapsed";
+                break;
+            /* thread name */
+            case 'T':
+                type = "thread_name";
+                break;
+            /* unknown conversion is skipped */
+            default:
+                continue;
         }
-        /* add `rpos` by 1 for next char in loop */
-        rpos++;
+
+        flush_text();
+        registerComponent(type, format, spec);
     }
+    flush_text();
+}
 
-    /* ready for components registration */
-    registered_components_.clear();
-    registered_components_.reserve(pattern_components.size());
+inline void ComponentFactory::resolveLevelColors(const nlohmann::json& level_colors)
+{
+    for (size_t i = 0; i < LogLevel::kLevelNum; i++)
+    {
+        std::string level_str = LogLevel::to_string(static_cast<LogLevel::level>(i));
 
-    for (const auto& [type, format]: pattern_components)
+        /* convert to lowercase for JSON key-value pair matching */
+        std::transform(level_str.begin(), level_str.end(), level_str.begin(), ::tolower);
+
+        if (level_colors.contains(level_str))
+            level_colors_[i] = formatColor(level_colors[level_str].get<std::string>());
+        else
+            level_colors_[i].clear();
+    }
+}
+
+inline std::string ComponentFactory::formatColor(std::string_view format)
+{
+    const auto& color_map = Color::getColorMap();
+    /* default color is white */
+    int r = 255, g = 255, b = 255;
+
+    auto it = color_map.find(format);
+    try
+    {
+        /* if color is found, convert hex to rgb */
+        if (it != color_map.end())
+            /* std::tie allow to tie multiple variables as std::tuple */
+            std::tie(r, g, b) = Color::convertHexToRGB(it->second);
+        else
+        {
+            throw aw_logger::invalid_parameter(
+                std::string("Color ") + std::string(format)
+                + " not found, use default color 'white' instead."
+            );
+        }
+    } catch (const std::exception& ex)
     {
-        /* timestamp */
-        if (type == "t")
-            registered_components_.push_back({ "timestamp", "" });
+        std::cerr << ex.what() << '\n' << std::endl;
+    }
 
-        /* level */
-        else if (type == "p")
-            registered_components_.push_back({ "level", "" });
+    return std::format("\033[38;2;{};{};{}m", r, g, b);
+}
 
-        /* thread id */
-        else if (type == "i")
-            registered_components_.push_back({ "tid", "" });
+inline Formatter::Formatter(ComponentFactory::Ptr factory): factory_(std::move(factory))
+{
+    compile();
+}
 
-        /* file name */
-        else if (type == "f")
-            registered_components_.push_back({ "loc", "{file_name}" });
+inline void Formatter::compile()
+{
+    /* new id invalidates location caches of the old instructions in all threads */
+    static std::atomic<uint64_t> next_id { 1 };
+    id_ = next_id.fetch_add(1, std::memory_order_relaxed);
+    location_num_ = 0;
+
+    instructions_.clear();
+    literals_.clear();
+    level_colors_ = {};
+    has_color_ = false;
+    if (factory_ == nullptr)
+        return;
+
+    const auto& components = factory_->registered_components_;
+    const auto& specs = factory_->registered_specs_;
+
+    /* color wraps level and message wherever it is registered */
+    for (const auto& [type, format]: components)
+    {
+        if (type == "color")
+        {
+            level_colors_ = factory_->level_colors_;
+            has_color_ = true;
+            break;
+        }
+    }
 
-        /* function name */
-        else if (type == "n")
-            registered_components_.push_back({ "loc", "{function_name}" });
+    for (size_t i = 0; i < components.size(); i++)
+    {
+        const auto& [type, format] = components[i];
+        /* components pushed by user directly have no specification */
+        const auto spec = i < specs.size() ? specs[i] : ComponentFactory::component_spec_t {};
+        const auto compile_op = [this, &spec](opCode op, size_t digits = 0) {
+            instructions_.push_back({
+                .op_ = op,
+                .align_ = spec.align_,
+                .digits_ = static_cast<uint8_t>(digits),
+                .min_width_ = spec.min_width_,
+                .max_width_ = spec.max_width_,
+            });
+        };
+        const auto compile_colored = [this, &compile_op](opCode op) {
+            if (has_color_)
+                instructions_.push_back({ .op_ = opCode::COLOR });
+            compile_op(op);
+            if (has_color_)
+                instructions_.push_back({ .op_ = opCode::END_COLOR });
+        };
+
+        if (type == "timestamp")
+            compile_op(opCode::TIMESTAMP, getTimestampDigits(format));
+        else if (type == "level")
+            compile_colored(opCode::LEVEL);
+        else if (type == "tid")
+            compile_op(opCode::TID);
+        else if (type == "loc")
+            compileSourceLocation(format, spec);
+        else if (type == "msg")
+            compile_colored(opCode::MSG);
+        else if (type == "logger")
+            compile_op(opCode::LOGGER);
+        else if (type == "elapsed")
+            compile_op(opCode::ELAPSED);
+        else if (type == "thread_name")
+            compile_op(opCode::THREAD_NAME);
+        else if (type == "text")
+            compileText(format);
+    }
+}
 
-        /* line */
-        else if (type == "l")
-            registered_components_.push_back({ "loc", "{line}" });
+inline void Formatter::compileText(std::string_view text)
+{
+    if (text.empty())
+        return;
+
+    /* extend the last literal span if it ends at the tail of literal pool */
+    if (!instructions_.empty() && instructions_.back().op_ == opCode::TEXT
+        && instructions_.back().begin_ + instructions_.back().size_ == literals_.size())
+        instructions_.back().size_ += static_cast<uint32_t>(text.size());
+    else
+        instructions_.push_back({ .op_ = opCode::TEXT,
+                                  .begin_ = static_cast<uint32_t>(literals_.size()),
+                                  .size_ = static_cast<uint32_t>(text.size()) });
+    literals_ += text;
+}
 
-        /* log message */
-        else if (type == "m")
-            registered_components_.push_back({ "msg", "" });
+inline void
+Formatter::compileSourceLocation(std::string_view format, const ComponentFactory::component_spec_t& spec)
+{
+    const auto has_width = [](const instruction_t& instruction) {
+        return instruction.min_width_ != 0 || instruction.max_width_ != 0;
+    };
+    const bool is_plain = spec.min_width_ == 0 && spec.max_width_ == 0;
+
+    /**
+     * merge into the previous source location, e.g. `%f:%n:%l` of pattern, so that it's cached as a whole,
+     * spans are contiguous since literal pool is ONLY appended. locations with width are NOT merged
+     */
+    const auto size = instructions_.size();
+    if (is_plain && size >= 1 && instructions_[size - 1].op_ == opCode::LOCATION
+        && !has_width(instructions_[size - 1]))
+    {
+        instructions_[size - 1].size_ += static_cast<uint32_t>(format.size());
+        literals_ += format;
+        return;
+    }
+    if (is_plain && size >= 2 && instructions_[size - 1].op_ == opCode::TEXT
+        && instructions_[size - 2].op_ == opCode::LOCATION && !has_width(instructions_[size - 2])
+        && instructions_[size - 2].begin_ + instructions_[size - 2].size_ == instructions_[size - 1].begin_)
+    {
+        instructions_[size - 2].size_ += instructions_[size - 1].size_ + static_cast<uint32_t>(format.size());
+        literals_ += format;
+        instructions_.pop_back();
+        return;
+    }
+
+    instructions_.push_back({ .op_ = opCode::LOCATION,
+                              .align_ = spec.align_,
+                              .min_width_ = spec.min_width_,
+                              .max_width_ = spec.max_width_,
+                              .slot_ = static_cast<uint16_t>(location_num_++),
+                              .begin_ = static_cast<uint32_t>(literals_.size()),
+                              .size_ = static_cast<uint32_t>(format.size()) });
+    literals_ += format;
+}
+
+inline void Formatter::applyWidth(std::string& out, size_t begin, const instruction_t& instruction)
+{
+    size_t width = out.size() - begin;
+    if (instruction.max_width_ != 0 && width > instruction.max_width_)
+    {
+        /* DO NOT split a UTF-8 sequence, back off to boundary of code point */
+        size_t end = begin + instruction.max_width_;
+        while (end > begin && (static_cast<unsigned char>(out[end]) & 0xC0) == 0x80)
+        {
+            end--;
+        }
+        out.resize(end);
+        width = end - begin;
+    }
+    if (width >= instruction.min_width_)
+        return;
+
+    const size_t padding = instruction.min_width_ - width;
+    switch (instruction.align_)
+    {
+        case ComponentFactory::alignType::RIGHT:
+            out.insert(begin, padding, ' ');
+            break;
+        case ComponentFactory::alignType::LEFT:
+            out.append(padding, ' ');
+            break;
+        case ComponentFactory::alignType::CENTER:
+            out.insert(begin, padding / 2, ' ');
+            out.append(padding - padding / 2, ' ');
+            break;
+    }
+}
+
+inline Formatter::timestamp_cache_t& Formatter::getTimestampCache() noexcept
+{
+    static thread_local timestamp_cache_t timestamp_cache;
+    return timestamp_cache;
+}
+
+inline Formatter::location_cache_t& Formatter::getLocationCache() const
+{
+    static thread_local std::vector<location_cache_t> location_caches;
+
+    for (auto& cache: location_caches)
+    {
+        if (cache.id_ == id_)
+            return cache;
+    }
 
-        /* text in pattern, e.g. timestamp:[%t] => timestamp:[1760000000] */
-        else if (type == "s")
-            registered_components_.push_back({ "text", format });
+    if (location_caches.size() >= kMaxLocationCaches)
+        location_caches.erase(location_caches.begin());
+    location_caches.push_back({ id_, {} });
+    location_caches.back().location_caches_.resize(location_num_);
+    return location_caches.back();
+}
+
+inline void Formatter::appendLocation(
+    std::string& out,
+    const LogEvent::Ptr& event,
+    const instruction_t& instruction
+) const
+{
+    auto& cache = getLocationCache().location_caches_[instruction.slot_];
+    const auto* site = &event->getCallSite();
+
+    /* placeholders ONLY get rendered at the first log of call site in current thread */
+    auto it = cache.find(site);
+    if (it == cache.end())
+        it = cache.emplace(site, formatSourceLocation(event, getText(instruction))).first;
+    out += it->second;
+}
+
+inline size_t Formatter::getTimestampDigits(std::string_view precision)
+{
+    if (precision == "ms")
+        return 3;
+    if (precision == "us")
+        return 6;
+    return 9;
+}
+
+inline void
+Formatter::appendTimestamp(std::string& out, const LogEvent::Ptr& event, size_t digits) const
+{
+    using namespace std::chrono;
+
+    const auto sys_timestamp = event->getSysTimestamp();
+    const auto second = floor<seconds>(sys_timestamp);
+
+    /* time zone conversion and calendar math ONLY happen once per second */
+    auto& timestamp_cache = getTimestampCache();
+    if (second != timestamp_cache.second_)
+    {
+        const auto local_second = floor<seconds>(event->getTimestamp());
+        timestamp_cache.prefix_.clear();
+        std::format_to(std::back_inserter(timestamp_cache.prefix_), "[{:%F %T}", local_second);
+        timestamp_cache.second_ = second;
     }
+    out += timestamp_cache.prefix_;
+
+    /* render sub-second digits with zero padding, offset of time zone is whole minutes */
+    auto sub_second = static_cast<uint64_t>(duration_cast<nanoseconds>(sys_timestamp - second).count());
+    for (size_t i = digits; i < 9; i++)
+        sub_second /= 10;
+
+    char buffer[12] = { '.', '0', '0', '0', '0', '0', '0', '0', '0', '0', ']' };
+    for (size_t i = digits; i > 0; i--)
+    {
+        buffer[i] = static_cast<char>('0' + sub_second % 10);
+        sub_second /= 10;
+    }
+    buffer[digits + 1] = ']';
+    out.append(buffer, digits + 2);
 }
 
-inline Formatter::Formatter(ComponentFactory::Ptr factory): factory_(std::move(factory)) {}
+inline std::string Formatter::formatEvent(const LogEvent::Ptr& event) const
+{
+    /* validate log event pointer */
+    if (event == nullptr)
+        throw aw_logger::invalid_parameter("log event pointer is nullptr!");
+
+    std::string result;
+    result.reserve(event->getMsgView().size() + 256);
+    formatTo(result, event);
+    return result;
+}
+
+inline void Formatter::formatTo(std::string& out, const LogEvent::Ptr& event) const
+{
+    /* validate log event pointer */
+    if (event == nullptr)
+        throw aw_logger::invalid_parameter("log event pointer is nullptr!");
+
+    try
+    {
+        /* resolved color code of log level, empty if no color */
+        const auto level = static_cast<size_t>(event->getLogLevel());
+        const std::string_view color_code =
+            has_color_ && level < LogLevel::kLevelNum ? level_colors_[level] : std::string_view();
+
+        for (const auto& instruction: instructions_)
+        {
+            const size_t begin = out.size();
+            switch (instruction.op_)
+            {
+                case opCode::TEXT:
+                    out.append(literals_, instruction.begin_, instruction.size_);
+                    break;
+                case opCode::TIMESTAMP:
+                    appendTimestamp(out, event, instruction.digits_);
+                    break;
+                case opCode::LEVEL:
+                    out += '[';
+                    out += LogLevel::to_string_view(event->getLogLevel());
+                    out += ']';
+                    break;
+                case opCode::TID:
+                    std::format_to(std::back_inserter(out), "[tid: {}]", event->getThreadId());
+                    break;
+                case opCode::LOCATION:
+                    appendLocation(out, event, instruction);
+                    break;
+                case opCode::MSG:
+                    out += event->getMsgView();
+                    break;
+                case opCode::COLOR:
+                    out += color_code;
+                    break;
+                case opCode::END_COLOR:
+                    if (!color_code.empty())
+                        out += aw_logger::Color::endColor;
+                    break;
+                case opCode::LOGGER:
+                    out += '[';
+                    out += event->getLoggerName();
+                    out += ']';
+                    break;
+                case opCode::ELAPSED:
+                    std::format_to(std::back_inserter(out), "[{}ms]", getElapsedMs(event));
+                    break;
+                case opCode::THREAD_NAME:
+                    appendThreadName(out, event);
+                    break;
+            }
+
+            /* ONLY padded or truncated components pay for width */
+            if ((instruction.min_width_ | instruction.max_width_) != 0)
+                applyWidth(out, begin, instruction);
+        }
+    } catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << '\n' << std::endl;
+    }
+}
 
 std::string Formatter::formatComponents(
     const LogEvent::Ptr& event,
     const std::vector<std::pair<std::string, std::string>>& components
-)
+) const
 {
     /* validate log event pointer */
     if (event == nullptr)
@@ -276,6 +719,18 @@ std::string Formatter::formatComponents(
                     result += aw_logger::Color::endColor;
                 }
             }
+            else if (type == "logger")
+            {
+                result += formatLoggerName(event);
+            }
+            else if (type == "elapsed")
+            {
+                result += formatElapsed(event);
+            }
+            else if (type == "thread_name")
+            {
+                result += formatThreadName(event);
+            }
             else if (type == "text")
             {
                 result += format;
@@ -288,36 +743,13 @@ std::string Formatter::formatComponents(
     return result;
 }
 
-inline std::string Formatter::formatColor(std::string_view format)
+inline std::string Formatter::formatColor(std::string_view format) const
 {
-    const auto& color_map = Color::getColorMap();
-    /* default color is white */
-    int r = 255, g = 255, b = 255;
-
-    auto it = color_map.find(format);
-    try
-    {
-        /* if color is found, convert hex to rgb */
-        if (it != color_map.end())
-            /* std::tie allow to tie multiple variables as std::tuple */
-            std::tie(r, g, b) = Color::convertHexToRGB(it->second);
-        else
-        {
-            throw aw_logger::invalid_parameter(
-                std::string("Color ") + std::string(format)
-                + " not found, use default color 'white' instead."
-            );
-        }
-    } catch (const std::exception& ex)
-    {
-        std::cerr << ex.what() << '\n' << std::endl;
-    }
-
-    return Formatter::vformat("\033[38;2;{};{};{}m", r, g, b);
+    return ComponentFactory::formatColor(format);
 }
 
 inline std::string
-Formatter::formatSourceLocation(const LogEvent::Ptr& event, std::string_view format)
+Formatter::formatSourceLocation(const LogEvent::Ptr& event, std::string_view format) const
 {
     auto const& loc = event->getSourceLocation();
     std::string result;
@@ -352,7 +784,7 @@ Formatter::formatSourceLocation(const LogEvent::Ptr& event, std::string_view for
     }
 
     result.append(format.data() + prev_pos, format.size() - prev_pos);
-    return Formatter::vformat("{}", result);
+    return result;
 }
 
 } // namespace aw_logger
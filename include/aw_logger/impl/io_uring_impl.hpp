@@ -0,0 +1,310 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMPL__IO_URING_IMPL_HPP
+#define IMPL__IO_URING_IMPL_HPP
+
+// C++ standard library
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+// aw_logger library
+#include "aw_logger/exception.hpp"
+#include "aw_logger/io_uring.hpp"
+
+namespace aw_logger {
+inline IoUring::IoUring(unsigned entries):
+    ring_fd_(-1),
+    entries_(0),
+    pending_num_(0),
+    sq_ring_(nullptr),
+    sq_ring_size_(0),
+    cq_ring_(nullptr),
+    cq_ring_size_(0),
+    sqes_(nullptr),
+    sqes_size_(0),
+    sq_head_(nullptr),
+    sq_tail_(nullptr),
+    sq_mask_(nullptr),
+    sq_array_(nullptr),
+    cq_head_(nullptr),
+    cq_tail_(nullptr),
+    cq_mask_(nullptr),
+    cqes_(nullptr)
+{
+#if AW_LOGGER_HAS_IO_URING
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (ring_fd_ < 0)
+        throw aw_logger::aw_logger_exception(std::string("failed to set up io_uring: ") + std::strerror(errno));
+    entries_ = params.sq_entries;
+
+    /* since Linux 5.4, both rings share ONE mapping */
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool is_single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (is_single_mmap)
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+    sq_ring_ = ::mmap(
+        nullptr,
+        sq_ring_size_,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        ring_fd_,
+        IORING_OFF_SQ_RING
+    );
+    if (sq_ring_ == MAP_FAILED)
+    {
+        sq_ring_ = nullptr;
+        release();
+        throw aw_logger::aw_logger_exception("failed to map submission queue of io_uring");
+    }
+
+    if (is_single_mmap)
+        cq_ring_ = sq_ring_;
+    else
+    {
+        cq_ring_ = ::mmap(
+            nullptr,
+            cq_ring_size_,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            ring_fd_,
+            IORING_OFF_CQ_RING
+        );
+        if (cq_ring_ == MAP_FAILED)
+        {
+            cq_ring_ = nullptr;
+            release();
+            throw aw_logger::aw_logger_exception("failed to map completion queue of io_uring");
+        }
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = ::mmap(
+        nullptr,
+        sqes_size_,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        ring_fd_,
+        IORING_OFF_SQES
+    );
+    if (sqes_ == MAP_FAILED)
+    {
+        sqes_ = nullptr;
+        release();
+        throw aw_logger::aw_logger_exception("failed to map submission queue entries of io_uring");
+    }
+
+    const auto field = [](void* ring, uint32_t offset) {
+        return reinterpret_cast<unsigned*>(static_cast<char*>(ring) + offset);
+    };
+    sq_head_ = field(sq_ring_, params.sq_off.head);
+    sq_tail_ = field(sq_ring_, params.sq_off.tail);
+    sq_mask_ = field(sq_ring_, params.sq_off.ring_mask);
+    sq_array_ = field(sq_ring_, params.sq_off.array);
+    cq_head_ = field(cq_ring_, params.cq_off.head);
+    cq_tail_ = field(cq_ring_, params.cq_off.tail);
+    cq_mask_ = field(cq_ring_, params.cq_off.ring_mask);
+    cqes_ = static_cast<char*>(cq_ring_) + params.cq_off.cqes;
+#else
+    static_cast<void>(entries);
+    throw aw_logger::aw_logger_exception("io_uring is not available on this platform");
+#endif
+}
+
+inline IoUring::~IoUring()
+{
+    release();
+}
+
+inline bool IoUring::isAvailable() noexcept
+{
+#if AW_LOGGER_HAS_IO_URING
+    /* positioned IORING_OP_WRITE comes with IORING_FEAT_RW_CUR_POS in Linux 5.6 */
+    static const bool is_available = []() {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        const auto fd = static_cast<int>(::syscall(__NR_io_uring_setup, 1, &params));
+        if (fd < 0)
+            return false;
+
+        ::close(fd);
+        return (params.features & IORING_FEAT_RW_CUR_POS) != 0;
+    }();
+    return is_available;
+#else
+    return false;
+#endif
+}
+
+inline bool
+IoUring::prepareWrite(int fd, const void* data, unsigned size, uint64_t offset, uint64_t user_data) noexcept
+{
+#if AW_LOGGER_HAS_IO_URING
+    auto sqe = static_cast<io_uring_sqe*>(nextEntry());
+    if (sqe == nullptr)
+        return false;
+
+    sqe->opcode = IORING_OP_WRITE;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(data);
+    sqe->len = size;
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    commitEntry();
+    return true;
+#else
+    static_cast<void>(fd);
+    static_cast<void>(data);
+    static_cast<void>(size);
+    static_cast<void>(offset);
+    static_cast<void>(user_data);
+    return false;
+#endif
+}
+
+inline bool IoUring::prepareFsync(int fd, uint64_t user_data, bool is_data_only) noexcept
+{
+#if AW_LOGGER_HAS_IO_URING
+    auto sqe = static_cast<io_uring_sqe*>(nextEntry());
+    if (sqe == nullptr)
+        return false;
+
+    sqe->opcode = IORING_OP_FSYNC;
+    sqe->fd = fd;
+    sqe->fsync_flags = is_data_only ? IORING_FSYNC_DATASYNC : 0;
+    /* writes inside ring run concurrently, so fsync drains all of them first */
+    sqe->flags = IOSQE_IO_DRAIN;
+    sqe->user_data = user_data;
+    commitEntry();
+    return true;
+#else
+    static_cast<void>(fd);
+    static_cast<void>(user_data);
+    static_cast<void>(is_data_only);
+    return false;
+#endif
+}
+
+template<typename CompleteFn>
+void IoUring::submitAndWait(unsigned wait_num, CompleteFn&& on_complete)
+{
+#if AW_LOGGER_HAS_IO_URING
+    enter(wait_num);
+
+    unsigned done_num = 0;
+    while (done_num < wait_num)
+    {
+        /* completion queue tail is written by kernel */
+        unsigned head = *cq_head_;
+        const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+        for (; head != tail; head++, done_num++)
+        {
+            const auto& cqe = static_cast<const io_uring_cqe*>(cqes_)[head & *cq_mask_];
+            on_complete(cqe.user_data, cqe.res);
+        }
+        std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+
+        if (done_num < wait_num)
+            enter(wait_num - done_num);
+    }
+#else
+    static_cast<void>(wait_num);
+    static_cast<void>(on_complete);
+#endif
+}
+
+inline void* IoUring::nextEntry() noexcept
+{
+#if AW_LOGGER_HAS_IO_URING
+    /* submission queue head is written by kernel, and tail is ONLY written here */
+    const unsigned head = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+    const unsigned tail = *sq_tail_;
+    if (tail - head >= entries_)
+        return nullptr;
+
+    auto sqe = static_cast<io_uring_sqe*>(sqes_) + (tail & *sq_mask_);
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    return sqe;
+#else
+    return nullptr;
+#endif
+}
+
+inline void IoUring::commitEntry() noexcept
+{
+#if AW_LOGGER_HAS_IO_URING
+    /* publish entry to kernel after it's filled */
+    const unsigned tail = *sq_tail_;
+    const unsigned index = tail & *sq_mask_;
+    sq_array_[index] = index;
+    std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release);
+    pending_num_++;
+#endif
+}
+
+inline void IoUring::enter(unsigned wait_num)
+{
+#if AW_LOGGER_HAS_IO_URING
+    while (true)
+    {
+        const auto ret = ::syscall(
+            __NR_io_uring_enter,
+            ring_fd_,
+            pending_num_,
+            wait_num,
+            IORING_ENTER_GETEVENTS,
+            nullptr,
+            0
+        );
+        if (ret >= 0)
+        {
+            pending_num_ -= static_cast<unsigned>(ret);
+            return;
+        }
+        if (errno != EINTR)
+            throw aw_logger::aw_logger_exception(std::string("failed to enter io_uring: ") + std::strerror(errno));
+    }
+#else
+    static_cast<void>(wait_num);
+#endif
+}
+
+inline void IoUring::release() noexcept
+{
+#if AW_LOGGER_HAS_IO_URING
+    if (sqes_ != nullptr)
+        ::munmap(sqes_, sqes_size_);
+    if (cq_ring_ != nullptr && cq_ring_ != sq_ring_)
+        ::munmap(cq_ring_, cq_ring_size_);
+    if (sq_ring_ != nullptr)
+        ::munmap(sq_ring_, sq_ring_size_);
+    if (ring_fd_ >= 0)
+        ::close(ring_fd_);
+#endif
+    sqes_ = nullptr;
+    cq_ring_ = nullptr;
+    sq_ring_ = nullptr;
+    ring_fd_ = -1;
+}
+
+} // namespace aw_logger
+
+#endif //! IMPL__IO_URING_IMPL_HPP
@@ -19,6 +19,11 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+// C++ standard library
+#include <iterator>
+#include <mutex>
+#include <set>
+
 // aw_logger library
 #include "aw_logger/log_event.hpp"
 
@@ -29,19 +34,157 @@ LogEvent::LogEvent(
     LocalSourceLocation<std::string> wrapped_msg
 ):
     logger_(std::move(logger)),
-    level_(level),
-    timestamp_({ std::chrono::current_zone(), std::chrono::system_clock::now() }),
-    wrapped_msg_(std::move(wrapped_msg)),
-    thread_id_(LogEvent::getThreadId())
+    site_(&CallSite::intern(level, wrapped_msg.getLocation())),
+    stamp_source_(TickClock::source::SYSTEM),
+    stamp_(TickClock::now(TickClock::source::SYSTEM)),
+    msg_(std::move(wrapped_msg.getData())),
+    thread_id_(currentThreadId()),
+    thread_name_(currentThreadName()),
+    spec_(nullptr),
+    format_fn_(nullptr),
+    destroy_fn_(nullptr)
+{}
+
+inline LogEvent::LogEvent():
+    logger_(nullptr),
+    site_(&kDefaultSite),
+    stamp_source_(TickClock::source::SYSTEM),
+    stamp_(TickClock::now(TickClock::source::SYSTEM)),
+    msg_(),
+    thread_id_(0),
+    thread_name_(nullptr),
+    spec_(nullptr),
+    format_fn_(nullptr),
+    destroy_fn_(nullptr)
 {}
 
-inline size_t LogEvent::getThreadId() const noexcept
+inline LogEvent::~LogEvent()
+{
+    clearArgs();
+}
+
+inline void LogEvent::reset(Logger::Ptr logger, const CallSite& site, TickClock::source src)
+{
+    logger_ = std::move(logger);
+    site_ = &site;
+    stamp_source_ = src;
+    stamp_ = TickClock::now(src);
+    msg_.clear();
+    clearArgs();
+    thread_id_ = currentThreadId();
+    thread_name_ = currentThreadName();
+}
+
+template<typename... Args>
+void LogEvent::formatMsg(std::string_view fmt, const Args&... args)
+{
+    msg_.clear();
+    std::vformat_to(std::back_inserter(msg_), fmt, std::make_format_args(args...));
+}
+
+template<typename... Args>
+void LogEvent::formatMsg(const FormatSpec& spec, const Args&... args)
+{
+    msg_.clear();
+    spec.formatTo(msg_, args...);
+}
+
+template<typename... Args>
+void LogEvent::deferFormat(const FormatSpec& spec, const Args&... args)
+{
+    using args_t = std::tuple<captured_t<Args>...>;
+
+    /* captured arguments don't fit in inline storage, format immediately */
+    if constexpr (sizeof(args_t) > kMaxArgsSize || alignof(args_t) > alignof(std::max_align_t)
+                  || !(std::is_copy_constructible_v<captured_t<Args>> && ...))
+    {
+        formatMsg(spec, args...);
+    }
+    else
+    {
+        clearArgs();
+        ::new (static_cast<void*>(args_)) args_t(captured_t<Args>(args)...);
+        spec_ = &spec;
+        format_fn_ = [](const void* captured_args, const FormatSpec& spec, std::string& msg) {
+            std::apply(
+                [&spec, &msg](const auto&... unpacked_args) {
+                    msg.clear();
+                    spec.formatTo(msg, unpacked_args...);
+                },
+                *static_cast<const args_t*>(captured_args)
+            );
+        };
+        destroy_fn_ = [](void* captured_args) noexcept {
+            static_cast<args_t*>(captured_args)->~args_t();
+        };
+    }
+}
+
+inline void LogEvent::formatDeferred() noexcept
+{
+    if (format_fn_ == nullptr)
+        return;
+
+    try
+    {
+        format_fn_(args_, *spec_, msg_);
+    } catch (const std::exception& ex)
+    {
+        msg_.assign(ex.what());
+    } catch (...)
+    {
+        msg_.assign("unknown exception while formatting deferred message.");
+    }
+    clearArgs();
+}
+
+inline void LogEvent::clearArgs() noexcept
+{
+    if (destroy_fn_ != nullptr)
+        destroy_fn_(args_);
+
+    format_fn_ = nullptr;
+    destroy_fn_ = nullptr;
+}
+
+inline const std::chrono::time_zone* LogEvent::getTimeZone()
+{
+    static const std::chrono::time_zone* const time_zone = std::chrono::current_zone();
+    return time_zone;
+}
+
+inline void LogEvent::setThreadName(std::string_view name)
+{
+    if (name.empty())
+    {
+        currentThreadName() = nullptr;
+        return;
+    }
+
+    /* node-based set keeps address of interned name stable */
+    static std::mutex names_mtx;
+    static std::set<std::string, std::less<>> names;
+
+    std::lock_guard<std::mutex> lk(names_mtx);
+    auto it = names.find(name);
+    if (it == names.end())
+        it = names.emplace(name).first;
+    currentThreadName() = &*it;
+}
+
+inline size_t LogEvent::currentThreadId() noexcept
 {
     static thread_local size_t thread_id = _getThreadId();
     return thread_id;
 }
 
-inline size_t LogEvent::_getThreadId() const noexcept
+inline const std::string*& LogEvent::currentThreadName() noexcept
+{
+    static thread_local const std::string* thread_name = nullptr;
+    return thread_name;
+}
+
+inline size_t LogEvent::_getThreadId() noexcept
 {
 #ifdef _WIN32
     return static_cast<size_t>(::GetCurrentThreadId());
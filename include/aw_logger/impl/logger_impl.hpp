@@ -17,18 +17,49 @@
 
 // C++ standard library
 #include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <typeinfo>
 #include <vector>
 
+// nlohmann JSON library
+#include <nlohmann/json.hpp>
+
 // aw_logger library
+#include "aw_logger/event_pool.hpp"
 #include "aw_logger/exception.hpp"
 #include "aw_logger/logger.hpp"
+#include "aw_logger/pipeline.hpp"
+#include "aw_logger/settings_path.h"
 
 namespace aw_logger {
-inline Logger::Logger(const std::string& name, const LogLevel::level lvl):
-    rb_(256),
+inline Logger::Logger(const std::string& name, const LogLevel::level lvl, const size_t capacity):
+    rb_(capacity),
+    event_pool_(std::make_shared<EventPool>(2 * rb_.getCapacity())),
+    inline_rb_(nullptr),
+    inline_events_(false),
+    has_inline_rb_(false),
+    deferred_format_(false),
+    clock_source_(TickClock::source::SYSTEM),
+    steady_converter_(TickClock::source::STEADY),
+    tsc_converter_(nullptr),
     threshold_level_(lvl),
     running_(false),
+    draining_(false),
+    sleeping_(false),
+    overflow_policy_(overflowPolicy::DROP_NEWEST),
+    dropped_count_(0),
+    evicting_num_(0),
+    unlocked_popping_(false),
+    blocked_num_(0),
+    has_overflow_(false),
+    max_overflow_size_(kDefaultMaxOverflowSize),
+    appenders_(std::make_shared<const appender_snapshot_t>()),
+    appenders_version_(0),
+    has_appenders_(false),
+    worker_appenders_(nullptr),
+    pipeline_(nullptr),
+    has_pipeline_(false),
     name_(name)
 {}
 
@@ -46,25 +77,15 @@ void Logger::submit(const std::shared_ptr<LogEvent>& event)
     if (event == nullptr || event->getLogLevel() < curr_level)
         return;
 
-    /* get status of appenders list via thread-safe copy */
-    bool has_appenders = false;
-    {
-        std::shared_lock<std::shared_mutex> read_lk(rw_mtx_);
-        has_appenders = !appenders_.empty();
-    }
-
     /* check whether it have own appenders */
-    if (has_appenders)
+    if (has_appenders_.load(std::memory_order_acquire))
     {
         /* if current logger has appenders, start it for once, after once, it will return via CAS operation */
         start();
 
-        /* if get new event, notify worker thread via `std::condition_variable` */
-        if (rb_.push(event))
-        {
-            std::unique_lock<std::mutex> cv_lk(cv_mtx_);
-            cv_.notify_one();
-        }
+        /* if get new event, notify worker thread via `std::condition_variable` if it's parked */
+        if (enqueue(event))
+            notifyWorker();
         return;
     }
 
@@ -81,6 +102,321 @@ void Logger::submit(const std::shared_ptr<LogEvent>& event)
         throw aw_logger::invalid_parameter("root logger is nullptr!");
 }
 
+inline std::shared_ptr<LogEvent>
+Logger::makeEvent(LogLevel::level level, const std::source_location& loc, std::string_view msg)
+{
+    auto event = event_pool_->acquire();
+    event->reset(shared_from_this(), level, loc, getClockSource());
+    event->setMsg(msg);
+    return event;
+}
+
+template<typename... Args>
+std::shared_ptr<LogEvent> Logger::makeFmtEvent(
+    LogLevel::level level,
+    const std::source_location& loc,
+    std::string_view fmt,
+    const Args&... args
+)
+{
+    auto event = event_pool_->acquire();
+    event->reset(shared_from_this(), level, loc, getClockSource());
+    event->formatMsg(fmt, args...);
+    return event;
+}
+
+inline void Logger::log(LogLevel::level level, const std::source_location& loc, std::string_view msg)
+{
+    /* skip interning call site if log level is filtered anyway */
+    if (level < getThresholdLevel())
+        return;
+
+    log(CallSite::intern(level, loc), msg);
+}
+
+inline void Logger::log(const CallSite& site, std::string_view msg)
+{
+    const auto fill_msg = [msg](LogEvent& event) { event.setMsg(msg); };
+    emit(shared_from_this(), site, fill_msg);
+}
+
+template<typename... Args>
+void Logger::logFmt(
+    LogLevel::level level,
+    const std::source_location& loc,
+    std::string_view fmt,
+    const Args&... args
+)
+{
+    if (level < getThresholdLevel())
+        return;
+
+    const auto fill_msg = [&fmt, &args...](LogEvent& event) { event.formatMsg(fmt, args...); };
+    emit(shared_from_this(), CallSite::intern(level, loc), fill_msg);
+}
+
+template<typename... Args>
+void Logger::logFmt(const CallSite& site, std::format_string<const Args&...> fmt, const Args&... args)
+{
+    /* `fmt` is ONLY for compile-time check, format string of call site is parsed from the same string */
+    (void)fmt;
+    const auto* spec = site.getFormatSpec();
+    if (spec == nullptr)
+        throw aw_logger::invalid_parameter("call site has no format string!");
+
+    if (!isDeferredFormat())
+    {
+        const auto fill_msg = [spec, &args...](LogEvent& event) { event.formatMsg(*spec, args...); };
+        emit(shared_from_this(), site, fill_msg);
+        return;
+    }
+
+    const auto fill_msg = [spec, &args...](LogEvent& event) { event.deferFormat(*spec, args...); };
+    emit(shared_from_this(), site, fill_msg);
+}
+
+inline void Logger::setInlineEvents(bool enable)
+{
+    if (enable)
+    {
+        std::call_once(inline_flag_, [this]() {
+            inline_rb_ = std::make_unique<MPSCRingBuffer<LogEvent>>(rb_.getCapacity());
+            has_inline_rb_.store(true, std::memory_order_release);
+        });
+    }
+    inline_events_.store(enable, std::memory_order_release);
+}
+
+inline size_t Logger::getDroppedCount(const std::shared_ptr<BaseAppender>& appender) const
+{
+    if (!has_pipeline_.load(std::memory_order_acquire))
+        return 0;
+
+    const auto pipeline = pipeline_.load(std::memory_order_acquire);
+    return pipeline != nullptr ? pipeline->getDroppedCount(appender) : 0;
+}
+
+inline void Logger::setAppenderPipeline(bool enable, size_t format_thread_num, size_t queue_capacity)
+{
+    if (enable && queue_capacity == 0)
+        throw aw_logger::invalid_parameter("queue capacity of appender pipeline must be greater than 0!");
+
+    auto pipeline =
+        enable ? std::make_shared<AppenderPipeline>(format_thread_num, queue_capacity) : nullptr;
+    has_pipeline_.store(enable, std::memory_order_release);
+
+    /* old pipeline writes out its queues once worker thread releases it */
+    pipeline_.store(std::move(pipeline), std::memory_order_release);
+}
+
+template<typename MsgFn>
+void Logger::emit(const Logger::Ptr& origin, const CallSite& site, const MsgFn& fill_msg)
+{
+    /* check status of log level */
+    if (site.getLogLevel() < getThresholdLevel())
+        return;
+
+    /* if it do not have own appenders, alter to root logger to append, the same as `submit()` */
+    if (!has_appenders_.load(std::memory_order_acquire))
+    {
+        Logger::Ptr curr_root_logger;
+        {
+            std::shared_lock<std::shared_mutex> read_lk(rw_mtx_);
+            curr_root_logger = root_logger_;
+        }
+
+        if (curr_root_logger == nullptr)
+            throw aw_logger::invalid_parameter("root logger is nullptr!");
+        curr_root_logger->emit(origin, site, fill_msg);
+        return;
+    }
+
+    start();
+
+    /* construct log event in place inside ringbuffer cell */
+    if (isInlineEvents())
+    {
+        if (enqueueInline(origin, site, fill_msg))
+            notifyWorker();
+        return;
+    }
+
+    /* or construct log event from event pool */
+    auto event = event_pool_->acquire();
+    event->reset(origin, site, origin->getClockSource());
+    fill_msg(*event);
+    if (enqueue(event))
+        notifyWorker();
+}
+
+template<typename MsgFn>
+bool Logger::enqueueInline(const Logger::Ptr& origin, const CallSite& site, const MsgFn& fill_msg)
+{
+    /* release logger if message fails to be filled, then worker thread skips this cell */
+    const auto fill_event = [&](LogEvent& event) {
+        event.reset(origin, site, origin->getClockSource());
+        try
+        {
+            fill_msg(event);
+        } catch (...)
+        {
+            event.recycle();
+            throw;
+        }
+    };
+
+    switch (getOverflowPolicy())
+    {
+        /* log events inside ringbuffer are appended in place, so the oldest one can't be evicted */
+        case overflowPolicy::DROP_NEWEST:
+        case overflowPolicy::DROP_OLDEST:
+            if (inline_rb_->emplace(fill_event))
+                return true;
+            break;
+
+        case overflowPolicy::BLOCK:
+            if (blockingPush(
+                    [&]() { return inline_rb_->emplace(fill_event); },
+                    [this]() { return inline_rb_->getRestSize() > 0; }
+                ))
+                return true;
+            break;
+
+        case overflowPolicy::GROW:
+            /* keep FIFO order, DO NOT bypass log events which are already in overflow list */
+            if (!has_overflow_.load(std::memory_order_acquire) && inline_rb_->emplace(fill_event))
+                return true;
+            {
+                auto event = event_pool_->acquire();
+                fill_event(*event);
+                if (pushOverflow(event))
+                    return true;
+            }
+            break;
+    }
+
+    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool Logger::enqueue(const std::shared_ptr<LogEvent>& event)
+{
+    switch (getOverflowPolicy())
+    {
+        case overflowPolicy::DROP_NEWEST:
+            if (rb_.push(event))
+                return true;
+            break;
+
+        case overflowPolicy::DROP_OLDEST:
+            while (!rb_.push(event))
+            {
+                /* take turns with worker thread to pop out the oldest log event */
+                std::shared_ptr<LogEvent> oldest_event;
+                std::lock_guard<std::mutex> pop_lk(pop_mtx_);
+                evicting_num_.fetch_add(1, std::memory_order_seq_cst);
+                /* worker thread may have started popping without lock before it saw this producer */
+                while (unlocked_popping_.load(std::memory_order_seq_cst))
+                {
+                    std::this_thread::yield();
+                }
+                if (rb_.pop(oldest_event))
+                    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+                evicting_num_.fetch_sub(1, std::memory_order_release);
+            }
+            return true;
+
+        case overflowPolicy::BLOCK:
+            if (blockingPush(
+                    [&]() { return rb_.push(event); },
+                    [this]() { return rb_.getRestSize() > 0; }
+                ))
+                return true;
+            break;
+
+        case overflowPolicy::GROW:
+            /* keep FIFO order, DO NOT bypass log events which are already in overflow list */
+            if (!has_overflow_.load(std::memory_order_acquire) && rb_.push(event))
+                return true;
+            if (pushOverflow(event))
+                return true;
+            break;
+    }
+
+    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+template<typename TryFn, typename RoomFn>
+bool Logger::blockingPush(TryFn&& try_push, RoomFn&& has_room)
+{
+    for (size_t spin_num = 0; running_.load(std::memory_order_relaxed); spin_num++)
+    {
+        if (try_push())
+            return true;
+
+        /* spin for a bounded time first */
+        if (spin_num < kMaxSpinNum)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        /* then park until worker thread drains ringbuffer, timeout is a guard of lost wakeup */
+        blocked_num_.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> space_lk(space_mtx_);
+            space_cv_.wait_for(space_lk, std::chrono::milliseconds(1), [this, &has_room]() {
+                return has_room() || !running_.load(std::memory_order_relaxed);
+            });
+        }
+        blocked_num_.fetch_sub(1);
+    }
+
+    /* worker thread has stopped, nobody can make room */
+    return false;
+}
+
+inline bool Logger::pushOverflow(const std::shared_ptr<LogEvent>& event)
+{
+    std::lock_guard<std::mutex> overflow_lk(overflow_mtx_);
+    if (overflow_list_.size() >= getMaxOverflowSize())
+        return false;
+
+    overflow_list_.emplace_back(event);
+    has_overflow_.store(true, std::memory_order_release);
+    return true;
+}
+
+inline bool Logger::hasPendingEvents() const noexcept
+{
+    return rb_.getSize() > 0 || has_overflow_.load(std::memory_order_acquire)
+        || (has_inline_rb_.load(std::memory_order_acquire) && inline_rb_->getSize() > 0);
+}
+
+inline void Logger::notifySpace()
+{
+    if (blocked_num_.load() > 0)
+    {
+        std::lock_guard<std::mutex> space_lk(space_mtx_);
+        space_cv_.notify_all();
+    }
+}
+
+inline void Logger::notifyWorker()
+{
+    /**
+     * pairs with the fence in worker thread: either worker thread sees the new log event before parking,
+     * or we see `sleeping_` here, so wakeup can't be lost
+     */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!sleeping_.load(std::memory_order_relaxed))
+        return;
+
+    std::unique_lock<std::mutex> cv_lk(cv_mtx_);
+    cv_.notify_one();
+}
+
 inline void Logger::setRootLogger(const Logger::Ptr& root_logger)
 {
     if (root_logger == nullptr)
@@ -101,9 +437,10 @@ inline void Logger::setAppender(const std::shared_ptr<BaseAppender>& appender)
 
     std::unique_lock<std::shared_mutex> write_lk(rw_mtx_);
     /* check existing and set appender under write lock for thread-safe */
+    auto appenders = getAppendersSnapshot()->appenders_;
     bool ok = std::any_of(
-        appenders_.begin(),
-        appenders_.end(),
+        appenders.begin(),
+        appenders.end(),
         [&appender](const std::shared_ptr<BaseAppender>& ex_app) { return (ex_app == appender); }
     );
     if (ok)
@@ -112,7 +449,8 @@ inline void Logger::setAppender(const std::shared_ptr<BaseAppender>& appender)
             + "has already setup!"
         );
 
-    appenders_.emplace_back(appender);
+    appenders.emplace_back(appender);
+    publishAppenders(std::move(appenders));
 }
 
 // clang-format off
@@ -139,11 +477,13 @@ void aw_logger::Logger::setAppenders(UArgs&&... appenders)
 inline void Logger::removeAppender(const std::shared_ptr<BaseAppender>& appender)
 {
     std::unique_lock<std::shared_mutex> write_lk(rw_mtx_);
-    for (auto it = appenders_.begin(); it != appenders_.end(); it++)
+    auto appenders = getAppendersSnapshot()->appenders_;
+    for (auto it = appenders.begin(); it != appenders.end(); it++)
     {
         if (*it == appender)
         {
-            appenders_.erase(it);
+            appenders.erase(it);
+            publishAppenders(std::move(appenders));
             return;
         }
     }
@@ -158,20 +498,41 @@ inline void Logger::removeAppender(const std::shared_ptr<BaseAppender>& appender
 inline void Logger::clearAppenders()
 {
     std::unique_lock<std::shared_mutex> write_lk(rw_mtx_);
-    appenders_.clear();
+    publishAppenders({});
+}
+
+inline void Logger::publishAppenders(std::vector<std::shared_ptr<BaseAppender>> appenders)
+{
+    auto snapshot = std::make_shared<appender_snapshot_t>();
+    snapshot->version_ = appenders_version_.load(std::memory_order_relaxed) + 1;
+    snapshot->appenders_ = std::move(appenders);
+    const auto version = snapshot->version_;
+    const bool has_appenders = !snapshot->appenders_.empty();
+
+    /* store snapshot before version, so that new version always comes with new snapshot */
+    appenders_.store(std::move(snapshot), std::memory_order_release);
+    appenders_version_.store(version, std::memory_order_release);
+    has_appenders_.store(has_appenders, std::memory_order_release);
 }
 
 inline void Logger::flush()
 {
-    /* wait until ringbuffer is empty */
-    while (rb_.getSize() > 0)
+    /* wait until ringbuffers and overflow list are empty and the last drained batch is appended */
+    while (hasPendingEvents() || draining_.load())
     {
         std::this_thread::yield();
     }
 
+    /* wait for I/O threads of appender pipeline */
+    if (has_pipeline_.load(std::memory_order_acquire))
+    {
+        if (const auto pipeline = pipeline_.load(std::memory_order_acquire))
+            pipeline->drain();
+    }
+
     /* flush all appenders, it change nothing about appenders list */
-    std::shared_lock<std::shared_mutex> read_lk(rw_mtx_);
-    for (const auto& app: appenders_)
+    const auto snapshot = getAppendersSnapshot();
+    for (const auto& app: snapshot->appenders_)
     {
         app->flush();
     }
@@ -195,6 +556,13 @@ void Logger::start()
     auto self = std::weak_ptr<Logger>(shared_from_this());
     /* worker thread */
     worker_ = std::thread([self]() {
+        /* local batch of log events, reused for each drain */
+        std::vector<LogEvent::Ptr> batch;
+        batch.reserve(kMaxBatchSize);
+        /* local batch of log events peeked in place from `inline_rb_` */
+        std::vector<LogEvent*> inline_events;
+        inline_events.reserve(kMaxBatchSize);
+
         /* keep running */
         while (true)
         {
@@ -207,53 +575,201 @@ void Logger::start()
              * wait for logger status(if not running, break the loop)
              * or new log event(size > 0, pop out to appender)
              */
-            std::unique_lock<std::mutex> cv_lk(logger->cv_mtx_);
-            logger->cv_.wait(cv_lk, [logger]() {
+            const auto is_ready = [&logger]() {
                 return !logger->running_.load(std::memory_order_relaxed)
-                    || logger->rb_.getSize() > 0;
-            });
+                    || logger->hasPendingEvents();
+            };
+
+            /* spin for a bounded time first, bursts of log events are picked up without parking */
+            for (size_t spin_num = 0; spin_num < kMaxSpinNum && !is_ready(); spin_num++)
+            {
+                std::this_thread::yield();
+            }
+
+            /* then park and advertise it, so producers know they have to notify */
+            if (!is_ready())
+            {
+                /* do NOT keep removed appenders alive while parking */
+                logger->worker_appenders_.reset();
+                if (logger->has_pipeline_.load(std::memory_order_acquire))
+                {
+                    if (const auto pipeline = logger->pipeline_.load(std::memory_order_acquire))
+                        pipeline->syncAppenders(logger->getAppendersSnapshot()->appenders_);
+                }
+
+                std::unique_lock<std::mutex> cv_lk(logger->cv_mtx_);
+                logger->sleeping_.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                logger->cv_.wait(cv_lk, is_ready);
+                logger->sleeping_.store(false, std::memory_order_relaxed);
+            }
 
-            /* check if logger is stopped and ringbuffer is empty */
-            if (!logger->running_.load(std::memory_order_relaxed) && logger->rb_.getSize() == 0)
+            /* check if logger is stopped, ringbuffers and overflow list are empty */
+            if (!logger->running_.load(std::memory_order_relaxed) && !logger->hasPendingEvents())
                 break;
 
-            /* pop out log event from ringbuffer */
-            LogEvent::Ptr out_event;
-            while (logger->rb_.pop(out_event))
+            /* drain log events from ringbuffers batch by batch, then from overflow list */
+            logger->draining_.store(true);
+            while (true)
             {
-                try
+                /**
+                 * producers pop ONLY while evicting in `overflowPolicy::DROP_OLDEST`, so the lock is skipped
+                 * unless one of them is evicting, an evicting producer waits until unlocked popping is done
+                 */
+                logger->unlocked_popping_.store(true, std::memory_order_seq_cst);
+                if (logger->evicting_num_.load(std::memory_order_seq_cst) == 0)
                 {
-                    /* copy appenders in order to avoid data race which is for thread safe */
-                    std::list<BaseAppender::Ptr> copy_appenders;
-                    /* after this block, read lock will be released, and we get copied variables */
-                    {
-                        std::shared_lock<std::shared_mutex> read_lk(logger->rw_mtx_);
-                        copy_appenders = logger->appenders_;
-                    }
+                    logger->rb_.pop_bulk(std::back_inserter(batch), kMaxBatchSize);
+                    logger->unlocked_popping_.store(false, std::memory_order_release);
+                }
+                else
+                {
+                    logger->unlocked_popping_.store(false, std::memory_order_release);
+                    std::lock_guard<std::mutex> pop_lk(logger->pop_mtx_);
+                    logger->rb_.pop_bulk(std::back_inserter(batch), kMaxBatchSize);
+                }
+
+                /* wake up parked producers since ringbuffer has room now */
+                if (!batch.empty())
+                    logger->notifySpace();
 
-                    /* submit to each appender */
-                    for (const auto& app: copy_appenders)
+                /* append log events constructed in place, cells are handed back after appended */
+                if (batch.empty() && logger->has_inline_rb_.load(std::memory_order_acquire))
+                {
+                    const size_t inline_num = logger->inline_rb_->peek_bulk(
+                        std::back_inserter(inline_events),
+                        kMaxBatchSize
+                    );
+                    if (inline_num > 0)
                     {
-                        app->append(out_event);
+                        /* non-owning pointers without control block, skip cells failed to be filled */
+                        for (LogEvent* event: inline_events)
+                        {
+                            if (event->getLogger() != nullptr)
+                                batch.emplace_back(LogEvent::Ptr(), event);
+                        }
+                        logger->dispatch(batch);
+                        batch.clear();
+
+                        for (LogEvent* event: inline_events)
+                        {
+                            event->recycle();
+                        }
+                        inline_events.clear();
+                        logger->inline_rb_->release(inline_num);
+                        logger->notifySpace();
+                        continue;
                     }
-                } catch (const std::exception& ex)
-                {
-                    std::cerr << ex.what() << '\n' << std::endl;
-                } catch (...)
+                }
+
+                /* ringbuffer is empty, take over the whole overflow list */
+                if (batch.empty() && logger->has_overflow_.load(std::memory_order_acquire))
                 {
-                    std::cerr << "unknown exception in logger worker thread.\n" << std::endl;
+                    std::lock_guard<std::mutex> overflow_lk(logger->overflow_mtx_);
+                    batch.swap(logger->overflow_list_);
+                    logger->has_overflow_.store(false, std::memory_order_release);
                 }
+
+                if (batch.empty())
+                    break;
+
+                logger->dispatch(batch);
+                batch.clear();
             }
+            logger->draining_.store(false);
         }
     });
 }
 
+inline void Logger::dispatch(std::span<const LogEvent::Ptr> events)
+{
+    try
+    {
+        /* reload snapshot of appenders ONLY if they have been changed */
+        if (worker_appenders_ == nullptr
+            || worker_appenders_->version_ != appenders_version_.load(std::memory_order_acquire))
+            worker_appenders_ = getAppendersSnapshot();
+
+        resolveTimestamps(events);
+
+        /* format deferred messages ONCE per log event before they are shared by appenders */
+        for (const auto& event: events)
+        {
+            event->formatDeferred();
+        }
+
+        /* hand the whole batch to appender pipeline, which returns once log events are formatted */
+        if (has_pipeline_.load(std::memory_order_acquire))
+        {
+            if (const auto pipeline = pipeline_.load(std::memory_order_acquire))
+            {
+                pipeline->dispatch(worker_appenders_->appenders_, events, getOverflowPolicy());
+                return;
+            }
+        }
+
+        /* or hand the whole batch to each appender */
+        for (const auto& app: worker_appenders_->appenders_)
+        {
+            app->appendBatch(events);
+        }
+    } catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << '\n' << std::endl;
+    } catch (...)
+    {
+        std::cerr << "unknown exception in logger worker thread.\n" << std::endl;
+    }
+}
+
+inline void Logger::resolveTimestamps(std::span<const LogEvent::Ptr> events)
+{
+    /* calibrate at most ONCE per batch */
+    bool steady_calibrated = false, tsc_calibrated = false;
+    for (const auto& event: events)
+    {
+        switch (event->getStampSource())
+        {
+            case TickClock::source::STEADY:
+                if (!steady_calibrated)
+                {
+                    steady_converter_.recalibrate();
+                    steady_calibrated = true;
+                }
+                event->resolveTimestamp(steady_converter_);
+                break;
+            case TickClock::source::TSC:
+                if (tsc_converter_ == nullptr)
+                    tsc_converter_ = std::make_unique<TickConverter>(TickClock::source::TSC);
+                if (!tsc_calibrated)
+                {
+                    tsc_converter_->recalibrate();
+                    tsc_calibrated = true;
+                }
+                event->resolveTimestamp(*tsc_converter_);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 inline void Logger::stop()
 {
     /* if `running_` is true, we gotta turn it off */
     bool expected = true;
     if (running_.compare_exchange_strong(expected, false))
-        cv_.notify_all();
+    {
+        {
+            /* worker thread may be parking, notify under the lock to avoid lost wakeup */
+            std::lock_guard<std::mutex> cv_lk(cv_mtx_);
+            cv_.notify_all();
+        }
+
+        /* release producers parked in `overflowPolicy::BLOCK` */
+        std::lock_guard<std::mutex> space_lk(space_mtx_);
+        space_cv_.notify_all();
+    }
 
     /* wait for the worker thread to finish */
     if (worker_.joinable())
@@ -265,11 +781,17 @@ inline LoggerManager::~LoggerManager()
     destroy();
 }
 
-inline Logger::Ptr LoggerManager::getLogger(const std::string& name)
+inline Logger::Ptr LoggerManager::getLogger(const std::string& name, size_t capacity)
 {
     /* if just want to get root logger, return directly */
     if (name == "root")
     {
+        /* root logger is created from settings before any call, so its capacity can NOT be specified here */
+        if (capacity != 0)
+            throw aw_logger::invalid_parameter(
+                "capacity of root logger can ONLY be preset in settings, can not specify it!"
+            );
+
         std::shared_lock<std::shared_mutex> read_lk(rw_mtx_);
         return root_logger_;
     }
@@ -288,9 +810,16 @@ inline Logger::Ptr LoggerManager::getLogger(const std::string& name)
     {
         std::shared_lock<std::shared_mutex> read_lk(rw_mtx_);
         copy_root_logger = root_logger_;
+
+        /* use preset capacity if not specified */
+        if (capacity == 0)
+        {
+            auto it = capacity_map_.find(name);
+            capacity = (it != capacity_map_.end()) ? it->second : Logger::kDefaultCapacity;
+        }
     }
 
-    Logger::Ptr logger = std::make_shared<Logger>(name);
+    Logger::Ptr logger = std::make_shared<Logger>(name, LogLevel::level::DEBUG, capacity);
     /* pass copy root logger instead of `this->root_logger_`, here we can use lock-free operation */
     logger->setRootLogger(copy_root_logger);
 
@@ -306,11 +835,33 @@ inline Logger::Ptr LoggerManager::getLogger(const std::string& name)
     }
 }
 
+inline void LoggerManager::setLoggerCapacity(const std::string& name, size_t capacity)
+{
+    if (capacity < 2)
+        throw aw_logger::invalid_parameter("capacity must be greater than 1!");
+
+    std::unique_lock<std::shared_mutex> write_lk(rw_mtx_);
+    /* ringbuffer of an existing logger can not be resized */
+    if (loggers_map_.contains(name))
+        throw aw_logger::invalid_parameter(
+            std::string("logger: ") + name + " has already been created, can not resize it!"
+        );
+
+    capacity_map_[name] = capacity;
+}
+
 inline void LoggerManager::init()
 {
     std::call_once(start_flag_, [this]() {
+        loadLoggerSettings(SETTINGS_FILE_PATH);
+
         std::unique_lock<std::shared_mutex> write_lk(rw_mtx_);
-        root_logger_ = std::make_shared<Logger>("root");
+        auto it = capacity_map_.find("root");
+        root_logger_ = std::make_shared<Logger>(
+            "root",
+            LogLevel::level::DEBUG,
+            (it != capacity_map_.end()) ? it->second : Logger::kDefaultCapacity
+        );
         root_logger_->setAppender(std::make_shared<ConsoleAppender>());
         loggers_map_.emplace("root", root_logger_);
         root_logger_->init();
@@ -322,6 +873,42 @@ inline void LoggerManager::destroy()
     loggers_map_.clear();
 }
 
+inline void LoggerManager::loadLoggerSettings(std::string_view file_name)
+{
+    /* settings of loggers are optional, use default capacity if missing */
+    std::ifstream setting_file { std::string(file_name) };
+    if (!setting_file.is_open())
+        return;
+
+    try
+    {
+        const auto setting_json = nlohmann::json::parse(setting_file);
+        if (!setting_json.contains("loggers") || !setting_json["loggers"].is_array())
+            return;
+
+        /* same checks as presetting in code, an invalid entry is reported and skipped */
+        for (const auto& logger_setting: setting_json["loggers"])
+        {
+            if (!logger_setting.contains("name") || !logger_setting.contains("capacity"))
+                continue;
+
+            try
+            {
+                setLoggerCapacity(
+                    logger_setting["name"].get<std::string>(),
+                    logger_setting["capacity"].get<size_t>()
+                );
+            } catch (const std::exception& ex)
+            {
+                std::cerr << ex.what() << '\n' << std::endl;
+            }
+        }
+    } catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << '\n' << std::endl;
+    }
+}
+
 } // namespace aw_logger
 
 #endif //! IMPL__LOGGER_IMPL_HPP
@@ -0,0 +1,389 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMPL__PIPELINE_IMPL_HPP
+#define IMPL__PIPELINE_IMPL_HPP
+
+// C++ standard library
+#include <algorithm>
+#include <iostream>
+
+// aw_logger library
+#include "aw_logger/pipeline.hpp"
+
+namespace aw_logger {
+inline FormatPool::FormatPool(size_t thread_num)
+{
+    threads_.reserve(thread_num);
+    for (size_t i = 0; i < thread_num; i++)
+    {
+        threads_.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+inline FormatPool::~FormatPool()
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        stopping_ = true;
+    }
+    run_cv_.notify_all();
+
+    for (auto& thread: threads_)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+}
+
+template<typename TaskFn>
+void FormatPool::run(size_t task_num, const TaskFn& task)
+{
+    if (task_num == 0)
+        return;
+
+    /* no need to wake up format threads for ONE task */
+    if (threads_.empty() || task_num == 1)
+    {
+        for (size_t i = 0; i < task_num; i++)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        task_ = &task;
+        task_fn_ = [](const void* task, size_t index) {
+            (*static_cast<const TaskFn*>(task))(index);
+        };
+        task_num_ = task_num;
+        next_task_.store(0, std::memory_order_relaxed);
+        generation_++;
+    }
+    run_cv_.notify_all();
+
+    /* calling thread works as well */
+    drainTasks(&task, task_fn_, task_num);
+
+    /* task lives in stack of caller, so wait until format threads leave the run */
+    std::unique_lock<std::mutex> lk(mtx_);
+    done_cv_.wait(lk, [this]() { return active_num_ == 0; });
+    task_ = nullptr;
+    task_num_ = 0;
+}
+
+inline void FormatPool::drainTasks(
+    const void* task,
+    void (*task_fn)(const void*, size_t),
+    size_t task_num
+) noexcept
+{
+    /* DO NOT touch counter of the next run if the run has been done */
+    if (task_num == 0)
+        return;
+
+    for (size_t index = next_task_.fetch_add(1, std::memory_order_relaxed); index < task_num;
+         index = next_task_.fetch_add(1, std::memory_order_relaxed))
+    {
+        task_fn(task, index);
+    }
+}
+
+inline void FormatPool::workerLoop()
+{
+    uint64_t seen_generation = 0;
+    std::unique_lock<std::mutex> lk(mtx_);
+    while (true)
+    {
+        run_cv_.wait(lk, [this, &seen_generation]() {
+            return stopping_ || generation_ != seen_generation;
+        });
+        if (stopping_)
+            return;
+
+        /* join the run under lock, so that calling thread waits for it */
+        seen_generation = generation_;
+        active_num_++;
+        const auto task = task_;
+        const auto task_fn = task_fn_;
+        const auto task_num = task_num_;
+        lk.unlock();
+
+        drainTasks(task, task_fn, task_num);
+
+        lk.lock();
+        if (--active_num_ == 0)
+            done_cv_.notify_all();
+    }
+}
+
+inline AppenderChannel::AppenderChannel(BaseAppender::Ptr appender, size_t capacity):
+    appender_(std::move(appender)),
+    capacity_(std::max<size_t>(capacity, 1))
+{
+    io_thread_ = std::thread([this]() { ioLoop(); });
+}
+
+inline AppenderChannel::~AppenderChannel()
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        stopping_ = true;
+    }
+    data_cv_.notify_all();
+
+    if (io_thread_.joinable())
+        io_thread_.join();
+}
+
+inline std::string AppenderChannel::acquireBuffer()
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (free_buffers_.empty())
+        return std::string();
+
+    auto buffer = std::move(free_buffers_.back());
+    free_buffers_.pop_back();
+    return buffer;
+}
+
+inline void AppenderChannel::recycleBuffer(std::string&& buffer)
+{
+    buffer.clear();
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (free_buffers_.size() < kMaxFreeNum)
+        free_buffers_.emplace_back(std::move(buffer));
+}
+
+inline size_t
+AppenderChannel::push(std::string&& buffer, size_t event_num, Logger::overflowPolicy policy)
+{
+    size_t dropped_num = 0;
+    {
+        std::unique_lock<std::mutex> lk(mtx_);
+        switch (policy)
+        {
+            case Logger::overflowPolicy::DROP_NEWEST:
+                if (queue_.size() >= capacity_)
+                {
+                    lk.unlock();
+                    recycleBuffer(std::move(buffer));
+                    dropped_num_.fetch_add(event_num, std::memory_order_relaxed);
+                    return event_num;
+                }
+                break;
+
+            case Logger::overflowPolicy::DROP_OLDEST:
+                while (queue_.size() >= capacity_)
+                {
+                    dropped_num += queue_.front().event_num_;
+                    queue_.pop_front();
+                }
+                dropped_num_.fetch_add(dropped_num, std::memory_order_relaxed);
+                break;
+
+            case Logger::overflowPolicy::BLOCK:
+                space_cv_.wait(lk, [this]() { return queue_.size() < capacity_; });
+                break;
+
+            case Logger::overflowPolicy::GROW:
+                break;
+        }
+        queue_.push_back({ std::move(buffer), event_num });
+    }
+    data_cv_.notify_one();
+    return dropped_num;
+}
+
+inline void AppenderChannel::drain()
+{
+    std::unique_lock<std::mutex> lk(mtx_);
+    space_cv_.wait(lk, [this]() { return queue_.empty() && !writing_; });
+}
+
+inline void AppenderChannel::ioLoop()
+{
+    /* buffers popped out of queue at once, and views of them for appender */
+    std::vector<std::string> buffers;
+    std::vector<std::string_view> views;
+
+    std::unique_lock<std::mutex> lk(mtx_);
+    while (true)
+    {
+        data_cv_.wait(lk, [this]() { return stopping_ || !queue_.empty(); });
+
+        /* buffers inside queue are written before I/O thread stops */
+        if (queue_.empty())
+            return;
+
+        /* take all the queued buffers, so that appender is able to gather them into ONE write */
+        while (!queue_.empty() && buffers.size() < kMaxGatherNum)
+        {
+            buffers.emplace_back(std::move(queue_.front().bytes_));
+            queue_.pop_front();
+        }
+        writing_ = true;
+        lk.unlock();
+        space_cv_.notify_all();
+
+        views.assign(buffers.begin(), buffers.end());
+        try
+        {
+            appender_->writeFormattedBatch(views);
+        } catch (const std::exception& ex)
+        {
+            std::cerr << ex.what() << '\n' << std::endl;
+        } catch (...)
+        {
+            std::cerr << "unknown exception in appender I/O thread.\n" << std::endl;
+        }
+
+        lk.lock();
+        writing_ = false;
+        for (auto& buffer: buffers)
+        {
+            if (free_buffers_.size() >= kMaxFreeNum)
+                break;
+            buffer.clear();
+            free_buffers_.emplace_back(std::move(buffer));
+        }
+        buffers.clear();
+        space_cv_.notify_all();
+    }
+}
+
+inline AppenderPipeline::AppenderPipeline(size_t format_thread_num, size_t queue_capacity):
+    queue_capacity_(queue_capacity),
+    pool_(format_thread_num)
+{}
+
+inline void AppenderPipeline::dispatch(
+    const std::vector<BaseAppender::Ptr>& appenders,
+    std::span<const LogEvent::Ptr> events,
+    Logger::overflowPolicy policy
+)
+{
+    std::lock_guard<std::mutex> channels_lk(channels_mtx_);
+    if (appenders != appenders_)
+        syncChannels(appenders);
+
+    /* appenders which are NOT formatted writable are appended on worker thread */
+    for (size_t i = 0; i < channels_.size(); i++)
+    {
+        if (channels_[i] == nullptr)
+            appenders_[i]->appendBatch(events);
+    }
+
+    const size_t channel_num = channels_.size();
+    const size_t chunk_num = (events.size() + kChunkSize - 1) / kChunkSize;
+    const size_t task_num = channel_num * chunk_num;
+    if (task_num == 0)
+        return;
+
+    buffers_.resize(task_num);
+    event_nums_.assign(task_num, 0);
+    for (size_t i = 0; i < task_num; i++)
+    {
+        if (channels_[i / chunk_num] != nullptr)
+            buffers_[i] = channels_[i / chunk_num]->acquireBuffer();
+    }
+
+    /* format chunks for each appender in parallel */
+    pool_.run(task_num, [&](size_t index) noexcept {
+        const auto& channel = channels_[index / chunk_num];
+        if (channel == nullptr)
+            return;
+
+        const size_t begin = (index % chunk_num) * kChunkSize;
+        const auto chunk = events.subspan(begin, std::min(kChunkSize, events.size() - begin));
+        try
+        {
+            event_nums_[index] = channel->getAppender()->formatBatch(buffers_[index], chunk);
+        } catch (const std::exception& ex)
+        {
+            std::cerr << ex.what() << '\n' << std::endl;
+        } catch (...)
+        {
+            std::cerr << "unknown exception in format thread.\n" << std::endl;
+        }
+    });
+
+    /* hand buffers to I/O thread of each appender in order, dropped log events are counted by channel */
+    for (size_t i = 0; i < task_num; i++)
+    {
+        auto& channel = channels_[i / chunk_num];
+        if (channel == nullptr)
+            continue;
+
+        if (buffers_[i].empty())
+            channel->recycleBuffer(std::move(buffers_[i]));
+        else
+            channel->push(std::move(buffers_[i]), event_nums_[i], policy);
+    }
+}
+
+inline void AppenderPipeline::syncAppenders(const std::vector<BaseAppender::Ptr>& appenders)
+{
+    std::lock_guard<std::mutex> channels_lk(channels_mtx_);
+    if (appenders != appenders_)
+        syncChannels(appenders);
+}
+
+inline void AppenderPipeline::drain()
+{
+    std::lock_guard<std::mutex> channels_lk(channels_mtx_);
+    for (const auto& channel: channels_)
+    {
+        if (channel != nullptr)
+            channel->drain();
+    }
+}
+
+inline size_t AppenderPipeline::getDroppedCount(const BaseAppender::Ptr& appender)
+{
+    std::lock_guard<std::mutex> channels_lk(channels_mtx_);
+    auto it = std::find(appenders_.begin(), appenders_.end(), appender);
+    if (it == appenders_.end())
+        return 0;
+
+    const auto& channel = channels_[static_cast<size_t>(it - appenders_.begin())];
+    return channel != nullptr ? channel->getDroppedNum() : 0;
+}
+
+inline void AppenderPipeline::syncChannels(const std::vector<BaseAppender::Ptr>& appenders)
+{
+    std::vector<std::unique_ptr<AppenderChannel>> channels;
+    channels.reserve(appenders.size());
+    for (const auto& appender: appenders)
+    {
+        /* reuse channel of existing appender, so that its queue keeps order */
+        auto it = std::find(appenders_.begin(), appenders_.end(), appender);
+        if (it != appenders_.end())
+            channels.emplace_back(std::move(channels_[static_cast<size_t>(it - appenders_.begin())]));
+        else if (appender->isFormattedWritable())
+            channels.emplace_back(std::make_unique<AppenderChannel>(appender, queue_capacity_));
+        else
+            channels.emplace_back(nullptr);
+    }
+
+    /* channels of removed appenders write out their queues and stop here */
+    channels_ = std::move(channels);
+    appenders_ = appenders;
+}
+
+} // namespace aw_logger
+
+#endif //! IMPL__PIPELINE_IMPL_HPP
@@ -19,8 +19,8 @@
 #include "aw_logger/ring_buffer.hpp"
 
 namespace aw_logger {
-template<typename DataT, typename Allocator>
-inline RingBuffer<DataT, Allocator>::RingBuffer(size_t capacity):
+template<typename DataT, typename Allocator, rbPolicy Policy>
+inline RingBuffer<DataT, Allocator, Policy>::RingBuffer(size_t capacity):
     buffer_(nullptr),
     alloc_(allocator_type()),
     wIdx_(0),
@@ -50,8 +50,8 @@ inline RingBuffer<DataT, Allocator>::RingBuffer(size_t capacity):
     rIdx_.store(0, std::memory_order_relaxed);
 }
 
-template<typename DataT, typename Allocator>
-RingBuffer<DataT, Allocator>::~RingBuffer()
+template<typename DataT, typename Allocator, rbPolicy Policy>
+RingBuffer<DataT, Allocator, Policy>::~RingBuffer()
 {
     if (buffer_ != nullptr)
     {
@@ -66,9 +66,16 @@ RingBuffer<DataT, Allocator>::~RingBuffer()
     }
 }
 
-template<typename DataT, typename Allocator>
+template<typename DataT, typename Allocator, rbPolicy Policy>
 template<typename U>
-bool RingBuffer<DataT, Allocator>::push(U&& data)
+bool RingBuffer<DataT, Allocator, Policy>::push(U&& data)
+{
+    return emplace([&data](value_t& cell_data) { cell_data = std::forward<U>(data); });
+}
+
+template<typename DataT, typename Allocator, rbPolicy Policy>
+template<typename Fn>
+bool RingBuffer<DataT, Allocator, Policy>::emplace(Fn&& fn)
 {
     /* check if ring buffer is valid */
     if (buffer_ == nullptr)
@@ -110,16 +117,25 @@ bool RingBuffer<DataT, Allocator>::push(U&& data)
         }
     }
 
-    /* update members of current cell */
-    curr_cell->data_ = std::forward<U>(data);
-    /* write operation；sequence = curr_wIdx + 1 */
-    curr_cell->sequence_.store(curr_wIdx + 1, std::memory_order_release);
+    /* write operation；sequence = curr_wIdx + 1, commit even if `fn` throws, or consumer stalls at this cell */
+    struct CommitGuard {
+        cell_t* cell_;
+        size_t seq_;
+
+        ~CommitGuard()
+        {
+            cell_->sequence_.store(seq_, std::memory_order_release);
+        }
+    } commit_guard { curr_cell, curr_wIdx + 1 };
+
+    /* update members of current cell in place */
+    std::forward<Fn>(fn)(curr_cell->data_);
 
     return true;
 }
 
-template<typename DataT, typename Allocator>
-bool RingBuffer<DataT, Allocator>::pop(value_t& data)
+template<typename DataT, typename Allocator, rbPolicy Policy>
+bool RingBuffer<DataT, Allocator, Policy>::pop(value_t& data)
 {
     /* check if ring buffer is valid */
     if (buffer_ == nullptr)
@@ -129,6 +145,20 @@ bool RingBuffer<DataT, Allocator>::pop(value_t& data)
     size_t curr_rIdx = rIdx_.load(std::memory_order_relaxed);
     cell_t* curr_cell;
 
+    /* single consumer owns read index, so a sequence check is enough to claim the cell */
+    if constexpr (Policy == rbPolicy::MPSC)
+    {
+        curr_cell = buffer_ + toPtr(curr_rIdx);
+        if (curr_cell->sequence_.load(std::memory_order_acquire) != curr_rIdx + 1)
+            return false;
+
+        data = std::move(curr_cell->data_);
+        curr_cell->sequence_.store(curr_rIdx + mask_ + 1, std::memory_order_release);
+        /* publish read index for `getSize()` */
+        rIdx_.store(curr_rIdx + 1, std::memory_order_release);
+        return true;
+    }
+
     /* loop until ready for read */
     while (true)
     {
@@ -163,8 +193,146 @@ bool RingBuffer<DataT, Allocator>::pop(value_t& data)
     return true;
 }
 
-template<typename DataT, typename Allocator>
-inline constexpr size_t RingBuffer<DataT, Allocator>::getSize() const noexcept
+template<typename DataT, typename Allocator, rbPolicy Policy>
+template<typename OutputIt>
+size_t RingBuffer<DataT, Allocator, Policy>::pop_bulk(OutputIt out, size_t max_n)
+{
+    /* check if ring buffer is valid */
+    if (buffer_ == nullptr || max_n == 0)
+        return 0;
+
+    size_t curr_rIdx = rIdx_.load(std::memory_order_relaxed);
+    size_t ready_num = 0;
+
+    /* single consumer owns read index, so counting ready cells is enough to claim them */
+    if constexpr (Policy == rbPolicy::MPSC)
+    {
+        while (ready_num < max_n)
+        {
+            const size_t idx = curr_rIdx + ready_num;
+            if (buffer_[toPtr(idx)].sequence_.load(std::memory_order_acquire) != idx + 1)
+                break;
+            ready_num++;
+        }
+    }
+    else
+    {
+        /* loop until a range of cells is claimed */
+        while (true)
+        {
+            /* count contiguous cells which are ready for read, start from `curr_rIdx` */
+            intptr_t head_used_size = 0;
+            ready_num = 0;
+            while (ready_num < max_n)
+            {
+                const size_t idx = curr_rIdx + ready_num;
+                size_t curr_seq = buffer_[toPtr(idx)].sequence_.load(std::memory_order_acquire);
+                intptr_t used_size =
+                    static_cast<intptr_t>(curr_seq) - static_cast<intptr_t>(idx + 1);
+
+                if (used_size != 0)
+                {
+                    if (ready_num == 0)
+                        head_used_size = used_size;
+                    break;
+                }
+                ready_num++;
+            }
+
+            if (ready_num > 0)
+            {
+                /* claim the whole range via ONE index update */
+                if (rIdx_.compare_exchange_weak(
+                        curr_rIdx,
+                        curr_rIdx + ready_num,
+                        std::memory_order_relaxed
+                    ))
+                    break;
+            }
+            /* here means all the data has been read */
+            else if (head_used_size < 0)
+            {
+                return 0;
+            }
+            /* another consumer has read this cell, load again and retry */
+            else
+            {
+                curr_rIdx = rIdx_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /* move out data and hand cells back to producers one by one */
+    for (size_t i = 0; i < ready_num; i++)
+    {
+        cell_t* curr_cell = buffer_ + toPtr(curr_rIdx + i);
+        *out = std::move(curr_cell->data_);
+        ++out;
+        /* read operation；sequence = curr_rIdx + i + mask_ + 1 */
+        curr_cell->sequence_.store(curr_rIdx + i + mask_ + 1, std::memory_order_release);
+    }
+
+    /* publish read index ONCE for the whole range */
+    if constexpr (Policy == rbPolicy::MPSC)
+    {
+        if (ready_num > 0)
+            rIdx_.store(curr_rIdx + ready_num, std::memory_order_release);
+    }
+
+    return ready_num;
+}
+
+template<typename DataT, typename Allocator, rbPolicy Policy>
+template<typename OutputIt>
+size_t RingBuffer<DataT, Allocator, Policy>::peek_bulk(OutputIt out, size_t max_n)
+{
+    static_assert(Policy == rbPolicy::MPSC, "`peek_bulk()` is ONLY for single consumer!");
+
+    /* check if ring buffer is valid */
+    if (buffer_ == nullptr)
+        return 0;
+
+    const size_t curr_rIdx = rIdx_.load(std::memory_order_relaxed);
+    size_t ready_num = 0;
+    while (ready_num < max_n)
+    {
+        const size_t idx = curr_rIdx + ready_num;
+        cell_t* curr_cell = buffer_ + toPtr(idx);
+        if (curr_cell->sequence_.load(std::memory_order_acquire) != idx + 1)
+            break;
+
+        *out = &curr_cell->data_;
+        ++out;
+        ready_num++;
+    }
+
+    return ready_num;
+}
+
+template<typename DataT, typename Allocator, rbPolicy Policy>
+void RingBuffer<DataT, Allocator, Policy>::release(size_t n)
+{
+    static_assert(Policy == rbPolicy::MPSC, "`release()` is ONLY for single consumer!");
+
+    if (buffer_ == nullptr || n == 0)
+        return;
+
+    const size_t curr_rIdx = rIdx_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < n; i++)
+    {
+        /* read operation；sequence = curr_rIdx + i + mask_ + 1 */
+        buffer_[toPtr(curr_rIdx + i)].sequence_.store(
+            curr_rIdx + i + mask_ + 1,
+            std::memory_order_release
+        );
+    }
+
+    /* publish read index ONCE for the whole range */
+    rIdx_.store(curr_rIdx + n, std::memory_order_release);
+}
+
+template<typename DataT, typename Allocator, rbPolicy Policy>
+inline constexpr size_t RingBuffer<DataT, Allocator, Policy>::getSize() const noexcept
 {
     const size_t curr_wIdx = wIdx_.load(std::memory_order_acquire);
     const size_t curr_rIdx = rIdx_.load(std::memory_order_acquire);
@@ -82,12 +82,71 @@ void aw_logger::WebsocketAppender::append(const LogEvent::Ptr& event)
     if (!connected_.load() || event->getLogLevel() < curr_level)
         return;
 
+    /* snapshot of formatter keeps components alive without lock */
+    const auto formatter = getFormatter();
+    std::string msg;
+    serializeTo(msg, *formatter, event);
+    send(msg);
+}
+
+size_t
+aw_logger::WebsocketAppender::formatBatch(std::string& out, std::span<const LogEvent::Ptr> events) const
+{
+    auto const curr_level = getThresholdLevel();
+    if (!connected_.load())
+        return 0;
+
+    const auto formatter = getFormatter();
+    size_t event_num = 0;
+    for (const auto& event: events)
+    {
+        if (event->getLogLevel() < curr_level)
+            continue;
+
+        /* reserve size prefix, then fill it once message is serialized */
+        const auto prefix_pos = out.size();
+        out.append(sizeof(uint32_t), '\0');
+        serializeTo(out, *formatter, event);
+        /* size prefix is in network byte order, so it does NOT depend on host */
+        const auto msg_size = static_cast<uint32_t>(out.size() - prefix_pos - sizeof(uint32_t));
+        for (size_t i = 0; i < sizeof(uint32_t); i++)
+        {
+            out[prefix_pos + i] = static_cast<char>((msg_size >> (8 * (sizeof(uint32_t) - 1 - i))) & 0xFF);
+        }
+        event_num++;
+    }
+    return event_num;
+}
+
+void aw_logger::WebsocketAppender::writeFormatted(std::string_view bytes)
+{
+    size_t pos = 0;
+    while (pos + sizeof(uint32_t) <= bytes.size())
+    {
+        uint32_t msg_size = 0;
+        for (size_t i = 0; i < sizeof(uint32_t); i++)
+        {
+            msg_size = (msg_size << 8) | static_cast<unsigned char>(bytes[pos + i]);
+        }
+        pos += sizeof(uint32_t);
+
+        frame_.assign(bytes.substr(pos, msg_size));
+        pos += msg_size;
+        send(frame_);
+    }
+}
+
+inline void aw_logger::WebsocketAppender::serializeTo(
+    std::string& out,
+    const Formatter& formatter,
+    const LogEvent::Ptr& event
+)
+{
     /* create json for message serialization */
     nlohmann::json log_msg_json;
     // clang-format off
     {
-        std::lock_guard<std::mutex> app_lk(app_mtx_);
-        auto const& components = formatter_->getRegisteredComponents();
+        auto const& components = formatter.getRegisteredComponents();
         for (auto const& [key, format]: components)
         {
             /* FIXME(siyiya): I have no idea how to format it without `std::format`, so if you have better approach, just pull request */
@@ -109,24 +168,32 @@ void aw_logger::WebsocketAppender::append(const LogEvent::Ptr& event)
             }
             else if (key == "msg")
                 log_msg_json["msg"] = event->getMsg();
+            else if (key == "logger")
+                log_msg_json["logger"] = event->getLoggerName();
+            else if (key == "thread_name")
+                log_msg_json["thread_name"] = event->getThreadName();
+            else if (key == "elapsed")
+                log_msg_json["elapsed"] = Formatter::getElapsedMs(event);
         }
     }
     // clang-format on
 
+    nlohmann::json::to_msgpack(log_msg_json, out);
+}
+
+inline void aw_logger::WebsocketAppender::send(const std::string& msg)
+{
     /* send binary to server */
-    auto const& binary_msg = nlohmann::json::to_msgpack(log_msg_json);
-    {
-        std::lock_guard<std::mutex> ws_lk(ws_mtx_);
-        /* prevent for destructor */
-        if (!connected_.load(std::memory_order_relaxed))
-            return;
+    std::lock_guard<std::mutex> ws_lk(ws_mtx_);
+    /* prevent for destructor */
+    if (!connected_.load(std::memory_order_relaxed))
+        return;
 
-        auto res = ws_.sendBinary(binary_msg);
-        if (!res.success)
-        {
-            std::cerr << "websocket send log message failed, payload size: " << res.payloadSize
-                      << ", wire size: " << res.wireSize << std::endl;
-        }
+    auto res = ws_.sendBinary(msg);
+    if (!res.success)
+    {
+        std::cerr << "websocket send log message failed, payload size: " << res.payloadSize
+                  << ", wire size: " << res.wireSize << std::endl;
     }
 }
 
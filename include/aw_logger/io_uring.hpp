@@ -0,0 +1,190 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IO_URING_HPP
+#define IO_URING_HPP
+
+// Linux library
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #define AW_LOGGER_HAS_IO_URING 1
+#else
+    #define AW_LOGGER_HAS_IO_URING 0
+#endif
+
+// C++ standard library
+#include <cstddef>
+#include <cstdint>
+
+/***
+ * @brief a low-latency, high-throughput and few-dependency logger for `AwakeLion Robot Lab` project
+ * @note fundamental structure is inspired by [sylar logger](https://github.com/sylar-yin/sylar) and implement is
+ * inspired by [log4j2](https://logging.apache.org/log4j/2.12.x/) and [minilog](https://github.com/archibate/minilog)
+ * @author jinhua "siyiovo" deng
+ */
+namespace aw_logger {
+/***
+ * @brief minimal io_uring ring for positioned writes and fsync, built on raw syscalls without liburing
+ * @details
+ * requests are prepared into submission queue, then submitted and reaped by ONE `io_uring_enter()`.
+ * it's NOT thread safe, each file appender owns its ring
+ * @note ONLY available on Linux 5.6+, check `isAvailable()` at runtime before constructing it
+ */
+class IoUring {
+public:
+    /***
+     * @brief default number of entries of submission queue
+     */
+    static constexpr unsigned kDefaultEntries = 64;
+
+    /***
+     * @brief constructor, set up ring and map its queues
+     * @param entries number of entries of submission queue, rounded up to power of 2 by kernel
+     */
+    explicit IoUring(unsigned entries = kDefaultEntries);
+
+    /***
+     * @brief destructor, unmap queues and close ring
+     */
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    /***
+     * @brief check whether kernel supports io_uring with `IORING_OP_WRITE`, probed once at runtime
+     * @return true if io_uring is available
+     */
+    static bool isAvailable() noexcept;
+
+    /***
+     * @brief get number of entries of submission queue
+     * @return number of entries of submission queue
+     */
+    inline unsigned getEntries() const noexcept
+    {
+        return entries_;
+    }
+
+    /***
+     * @brief prepare positioned write
+     * @param fd file descriptor
+     * @param data bytes to be written, it MUST keep valid until completion is reaped
+     * @param size size of bytes
+     * @param offset file offset
+     * @param user_data user data echoed by completion
+     * @return false if submission queue is full
+     */
+    bool prepareWrite(int fd, const void* data, unsigned size, uint64_t offset, uint64_t user_data) noexcept;
+
+    /***
+     * @brief prepare fsync which starts after all the requests prepared before it are completed
+     * @param fd file descriptor
+     * @param user_data user data echoed by completion
+     * @param is_data_only flag to sync data only like `fdatasync()`
+     * @return false if submission queue is full
+     */
+    bool prepareFsync(int fd, uint64_t user_data, bool is_data_only = true) noexcept;
+
+    /***
+     * @brief submit prepared requests and wait for their completions
+     * @tparam CompleteFn callable type, like `void(uint64_t user_data, int result)`
+     * @param wait_num number of completions to wait for
+     * @param on_complete callable for each completion, `result` is negative errno on failure
+     */
+    template<typename CompleteFn>
+    void submitAndWait(unsigned wait_num, CompleteFn&& on_complete);
+
+private:
+    /***
+     * @brief file descriptor of ring
+     */
+    int ring_fd_;
+
+    /***
+     * @brief number of entries of submission queue
+     */
+    unsigned entries_;
+
+    /***
+     * @brief number of prepared requests NOT submitted yet
+     */
+    unsigned pending_num_;
+
+    /***
+     * @brief mapped submission queue ring and its size
+     */
+    void* sq_ring_;
+    size_t sq_ring_size_;
+
+    /***
+     * @brief mapped completion queue ring and its size, it shares mapping of submission queue ring if possible
+     */
+    void* cq_ring_;
+    size_t cq_ring_size_;
+
+    /***
+     * @brief mapped submission queue entries and their size
+     */
+    void* sqes_;
+    size_t sqes_size_;
+
+    /***
+     * @brief fields of submission queue ring
+     */
+    unsigned* sq_head_;
+    unsigned* sq_tail_;
+    unsigned* sq_mask_;
+    unsigned* sq_array_;
+
+    /***
+     * @brief fields of completion queue ring
+     */
+    unsigned* cq_head_;
+    unsigned* cq_tail_;
+    unsigned* cq_mask_;
+
+    /***
+     * @brief completion queue entries inside completion queue ring
+     */
+    void* cqes_;
+
+    /***
+     * @brief get the next free submission queue entry without publishing it
+     * @return pointer to the cleared entry, `nullptr` if submission queue is full
+     */
+    void* nextEntry() noexcept;
+
+    /***
+     * @brief publish the entry got by `nextEntry()` to kernel
+     */
+    void commitEntry() noexcept;
+
+    /***
+     * @brief enter ring to submit requests and wait for completions
+     * @param wait_num number of completions to wait for
+     */
+    void enter(unsigned wait_num);
+
+    /***
+     * @brief unmap queues and close ring
+     */
+    void release() noexcept;
+};
+} // namespace aw_logger
+
+#endif //! IO_URING_HPP
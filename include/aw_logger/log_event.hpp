@@ -18,11 +18,19 @@
 // C++ standard library
 #include <chrono>
 #include <concepts>
+#include <format>
 #include <source_location>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <tuple>
+#include <type_traits>
 
 // aw_logger library
+#include "aw_logger/call_site.hpp"
+#include "aw_logger/clock.hpp"
 #include "aw_logger/fmt_base.hpp"
+#include "aw_logger/format_spec.hpp"
 #include "aw_logger/logger.hpp"
 
 /***
@@ -82,6 +90,23 @@ public:
             return data_;
         }
 
+        /***
+         * @brief get mutable input data, e.g. reuse message buffer of pooled log event
+         */
+        constexpr DataT& getData() noexcept
+        {
+            return data_;
+        }
+
+        /***
+         * @brief set local source location
+         * @param loc local source location
+         */
+        constexpr void setLocation(const std::source_location& loc) noexcept
+        {
+            loc_ = loc;
+        }
+
         /***
          * @brief get local source location
          */
@@ -117,13 +142,135 @@ public:
         LocalSourceLocation<std::string> wrapped_msg
     );
 
+    /***
+     * @brief default constructor for pooled log event, it MUST be reset before use
+     */
+    LogEvent();
+
+    /***
+     * @brief destructor, destroy captured format arguments if any
+     */
+    ~LogEvent();
+
+    /***
+     * @brief log event owns captured format arguments, so it's NOT copyable
+     */
+    LogEvent(const LogEvent&) = delete;
+    LogEvent& operator=(const LogEvent&) = delete;
+
+    /***
+     * @brief reset log event for a new log call
+     * @param logger logger
+     * @param site call site, it MUST have static storage duration, e.g. `static constexpr` one of `AW_LOG_*` macros
+     * @param src source of timestamp ticks, non-system ticks are converted later by `resolveTimestamp()`
+     * @details message buffer is cleared but keeps its capacity
+     */
+    void reset(
+        Logger::Ptr logger,
+        const CallSite& site,
+        TickClock::source src = TickClock::source::SYSTEM
+    );
+
+    /***
+     * @brief reset log event for a new log call with runtime log level and source location
+     * @param logger logger
+     * @param level log level
+     * @param loc source location of call site
+     * @param src source of timestamp ticks
+     * @details call site is interned, refer to `CallSite::intern()`
+     */
+    void reset(
+        Logger::Ptr logger,
+        LogLevel::level level,
+        const std::source_location& loc,
+        TickClock::source src = TickClock::source::SYSTEM
+    )
+    {
+        reset(std::move(logger), CallSite::intern(level, loc), src);
+    }
+
+    /***
+     * @brief convert raw ticks of timestamp to wall-clock time
+     * @param converter converter of the same source as ticks, otherwise it does nothing
+     */
+    inline void resolveTimestamp(const TickConverter& converter) noexcept
+    {
+        if (stamp_source_ == TickClock::source::SYSTEM || stamp_source_ != converter.getSource())
+            return;
+
+        stamp_ = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                converter.toSysTime(stamp_).time_since_epoch()
+            )
+                .count()
+        );
+        stamp_source_ = TickClock::source::SYSTEM;
+    }
+
+    /***
+     * @brief set input message via message buffer
+     * @param msg input message
+     */
+    inline void setMsg(std::string_view msg)
+    {
+        msg_.assign(msg);
+    }
+
+    /***
+     * @brief format input message into message buffer
+     * @tparam Args variadic template parameter
+     * @param fmt format string
+     * @param args variadic template parameter
+     */
+    template<typename... Args>
+    void formatMsg(std::string_view fmt, const Args&... args);
+
+    /***
+     * @brief format input message into message buffer with pre-parsed format string
+     * @tparam Args variadic template parameter
+     * @param spec pre-parsed format string
+     * @param args variadic template parameter
+     */
+    template<typename... Args>
+    void formatMsg(const FormatSpec& spec, const Args&... args);
+
+    /***
+     * @brief capture format arguments, and format message later via `formatDeferred()` on worker thread
+     * @tparam Args variadic template parameter
+     * @param spec pre-parsed format string, it MUST outlive log event, e.g. `static constexpr` one of call site
+     * @param args variadic template parameter
+     * @details
+     * arguments are copied into inline storage of log event:
+     * (1) string-like arguments(`std::string`, `std::string_view`, `const char*`) are copied as `std::string`
+     * (2) other arguments are copied by value
+     * if captured arguments are too large or NOT copyable, message is formatted immediately instead
+     */
+    template<typename... Args>
+    void deferFormat(const FormatSpec& spec, const Args&... args);
+
+    /***
+     * @brief format message from captured format arguments if any
+     * @details message is set to what the exception says if formatting throws
+     */
+    void formatDeferred() noexcept;
+
+    /***
+     * @brief release logger and captured format arguments before log event goes back to pool,
+     * message buffer keeps its capacity
+     */
+    inline void recycle() noexcept
+    {
+        logger_.reset();
+        clearArgs();
+    }
+
     /***
      * @brief get log level
      * @return log level
      */
     inline constexpr LogLevel::level getLogLevel() const noexcept
     {
-        return level_;
+        return site_->getLogLevel();
     }
 
     /***
@@ -132,7 +279,7 @@ public:
      */
     inline std::string getLogLevelString() const noexcept
     {
-        return LogLevel::to_string(level_);
+        return LogLevel::to_string(getLogLevel());
     }
 
     /***
@@ -142,7 +289,35 @@ public:
     inline const auto getTimestamp() const noexcept
         -> std::chrono::local_time<std::chrono::system_clock::duration>
     {
-        return timestamp_.get_local_time();
+        return getTimeZone()->to_local(getSysTimestamp());
+    }
+
+    /***
+     * @brief get timestamp in UTC without time zone conversion
+     * @return timestamp in UTC
+     * @note raw ticks which are not resolved yet are converted by `TickConverter::getDefault()`
+     */
+    inline const auto getSysTimestamp() const noexcept
+        -> std::chrono::sys_time<std::chrono::system_clock::duration>
+    {
+        using namespace std::chrono;
+        if (stamp_source_ == TickClock::source::SYSTEM)
+            return sys_time<system_clock::duration>(
+                system_clock::duration(static_cast<system_clock::rep>(stamp_))
+            );
+
+        return time_point_cast<system_clock::duration>(
+            TickConverter::getDefault(stamp_source_).toSysTime(stamp_)
+        );
+    }
+
+    /***
+     * @brief get source of timestamp ticks
+     * @return source of timestamp ticks, `TickClock::source::SYSTEM` once resolved
+     */
+    inline TickClock::source getStampSource() const noexcept
+    {
+        return stamp_source_;
     }
 
     /***
@@ -151,7 +326,16 @@ public:
      */
     inline const std::source_location& getSourceLocation() const noexcept
     {
-        return wrapped_msg_.getLocation();
+        return site_->getSourceLocation();
+    }
+
+    /***
+     * @brief get call site
+     * @return call site with static storage duration
+     */
+    inline const CallSite& getCallSite() const noexcept
+    {
+        return *site_;
     }
 
     /***
@@ -159,15 +343,51 @@ public:
      */
     inline std::string getMsg() const noexcept
     {
-        return wrapped_msg_.getData();
+        return msg_;
     }
 
     /***
-     * @brief get thread id from thread local storage
-     * @return thread id from thread local storage
-     * @details copied from [spdlog](https://github.com/gabime/spdlog)
+     * @brief get view of input message without copy
+     * @note it's valid until log event is reset or recycled
      */
-    inline size_t getThreadId() const noexcept;
+    inline std::string_view getMsgView() const noexcept
+    {
+        return msg_;
+    }
+
+    /***
+     * @brief get id of thread which made the log call
+     * @return thread id captured while constructing or resetting log event
+     */
+    inline size_t getThreadId() const noexcept
+    {
+        return thread_id_;
+    }
+
+    /***
+     * @brief get name of thread which made the log call
+     * @return thread name, empty if the thread is unnamed
+     */
+    inline std::string_view getThreadName() const noexcept
+    {
+        return thread_name_ != nullptr ? std::string_view(*thread_name_) : std::string_view();
+    }
+
+    /***
+     * @brief set name of current thread, which is captured by the following log events of this thread
+     * @param name thread name, empty means unnamed
+     * @details names are interned and never freed, so log events refer to them without copy
+     */
+    static void setThreadName(std::string_view name);
+
+    /***
+     * @brief get name of logger
+     * @return logger name, empty if log event has no logger
+     */
+    inline std::string_view getLoggerName() const noexcept
+    {
+        return logger_ != nullptr ? logger_->getNameView() : std::string_view();
+    }
 
     /***
      * @brief get logger
@@ -185,32 +405,108 @@ private:
     Logger::Ptr logger_;
 
     /***
-     * @brief level
+     * @brief call site which provides log level and source location
      */
-    LogLevel::level level_;
+    const CallSite* site_;
 
     /***
-     * @brief timestamp
-     * @note this is timestamp from your time zone
+     * @brief source of timestamp ticks
      */
-    std::chrono::zoned_time<std::chrono::system_clock::duration> timestamp_;
+    TickClock::source stamp_source_;
 
     /***
-     * @brief wrapped message includes source location and input message
+     * @brief timestamp ticks, ticks of `std::chrono::system_clock` in UTC once resolved
+     * @note time zone is applied ONLY when timestamp is read, refer to `getTimestamp()`
      */
-    LocalSourceLocation<std::string> wrapped_msg_;
+    uint64_t stamp_;
+
+    /***
+     * @brief message buffer
+     */
+    std::string msg_;
 
     /***
      * @brief thread id
      */
     size_t thread_id_;
 
+    /***
+     * @brief interned thread name, `nullptr` if the thread is unnamed
+     */
+    const std::string* thread_name_;
+
+    /***
+     * @brief size of inline storage for captured format arguments
+     */
+    static constexpr size_t kMaxArgsSize = 128;
+
+    /***
+     * @brief type of captured format argument
+     * @tparam T type of format argument
+     */
+    template<typename T>
+    using captured_t = std::conditional_t<
+        std::is_same_v<std::decay_t<T>, std::string> || std::is_same_v<std::decay_t<T>, std::string_view>
+            || std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>,
+        std::string,
+        std::decay_t<T>>;
+
+    /***
+     * @brief pre-parsed format string of captured format arguments
+     */
+    const FormatSpec* spec_;
+
+    /***
+     * @brief inline storage for captured format arguments
+     */
+    alignas(std::max_align_t) unsigned char args_[kMaxArgsSize];
+
+    /***
+     * @brief type-erased function to format message from captured format arguments
+     * @details `nullptr` means no captured format arguments
+     */
+    void (*format_fn_)(const void* args, const FormatSpec& spec, std::string& msg);
+
+    /***
+     * @brief type-erased function to destroy captured format arguments
+     */
+    void (*destroy_fn_)(void* args) noexcept;
+
+    /***
+     * @brief destroy captured format arguments if any
+     */
+    void clearArgs() noexcept;
+
     /***
      * @brief get thread id
      * @return thread id
      * @details copied from [spdlog](https://github.com/gabime/spdlog)
      */
-    inline size_t _getThreadId() const noexcept;
+    static inline size_t _getThreadId() noexcept;
+
+    /***
+     * @brief get id of current thread from thread local storage
+     * @return thread id of current thread
+     */
+    static inline size_t currentThreadId() noexcept;
+
+    /***
+     * @brief get interned name of current thread from thread local storage
+     * @return reference of interned name pointer of current thread
+     */
+    static inline const std::string*& currentThreadName() noexcept;
+
+    /***
+     * @brief get current time zone
+     * @return current time zone
+     * @note cached at first call, since `std::chrono::current_zone()` may look up time zone database each time
+     */
+    static const std::chrono::time_zone* getTimeZone();
+
+    /***
+     * @brief call site of log event which is NOT reset yet
+     */
+    static constexpr CallSite kDefaultSite { LogLevel::level::DEBUG, std::source_location() };
 };
 
 /***
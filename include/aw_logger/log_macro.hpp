@@ -23,10 +23,36 @@
 
 // aw_logger library
 #include "aw_logger/appender.hpp"
+#include "aw_logger/call_site.hpp"
+#include "aw_logger/event_pool.hpp"
 #include "aw_logger/fmt_base.hpp"
+#include "aw_logger/format_spec.hpp"
 #include "aw_logger/log_event.hpp"
 #include "aw_logger/logger.hpp"
 
+/***
+ * @brief numeric log levels for preprocessor, which are the same as `aw_logger::LogLevel::level`
+ */
+#define AW_LOGGER_LEVEL_DEBUG 1
+#define AW_LOGGER_LEVEL_INFO 2
+#define AW_LOGGER_LEVEL_NOTICE 3
+#define AW_LOGGER_LEVEL_WARN 4
+#define AW_LOGGER_LEVEL_ERROR 5
+#define AW_LOGGER_LEVEL_FATAL 6
+#define AW_LOGGER_LEVEL_OFF 7
+
+/***
+ * @brief compile-time minimum log level
+ * @details
+ * `AW_LOG_*` macros below this level expand to nothing, so neither their arguments are evaluated
+ * nor the threshold of logger is loaded, e.g. `-DAW_LOGGER_ACTIVE_LEVEL=AW_LOGGER_LEVEL_INFO` strips DEBUG logs.
+ * it's set by `active_level` option of xmake, or `AW_LOGGER_ACTIVE_LEVEL` cache variable of cmake
+ * @note runtime threshold of logger still works for the rest levels
+ */
+#ifndef AW_LOGGER_ACTIVE_LEVEL
+    #define AW_LOGGER_ACTIVE_LEVEL AW_LOGGER_LEVEL_DEBUG
+#endif
+
 /***
  * @brief a low-latency, high-throughput and few-dependency logger for `AwakeLion Robot Lab` project
  * @note fundamental structure is inspired by [sylar logger](https://github.com/sylar-yin/sylar) and implement is
@@ -37,23 +63,34 @@ namespace aw_logger {
 /***
  * @brief format input log message
  * @tparam Args variadic template parameter
- * @param fmt format string
+ * @param fmt format string, checked against `args` at compile time
  * @param args variadic template parameter
  * @return formatted message
  */
 template<typename... Args>
-std::string format_message(std::string_view fmt, const Args&... args)
+std::string format_message(std::format_string<const Args&...> fmt, const Args&... args)
 {
-    return std::vformat(fmt, std::make_format_args(args...));
+    return std::format(fmt, args...);
 }
 
+#define LOG_LEVEL_FUNC(name) \
+    static_assert(static_cast<int>(LogLevel::level::name) == AW_LOGGER_LEVEL_##name);
+LOG_LEVEL_FUNC(DEBUG)
+LOG_LEVEL_FUNC(INFO)
+LOG_LEVEL_FUNC(NOTICE)
+LOG_LEVEL_FUNC(WARN)
+LOG_LEVEL_FUNC(ERROR)
+LOG_LEVEL_FUNC(FATAL)
+#undef LOG_LEVEL_FUNC
+
 } // namespace aw_logger
 
 /***
  * @brief aw logger base macro definition
  * @param logger logger instance
- * @param level input log level
+ * @param level input log level, either a constant expression or a runtime value
  * @param msg log message
+ * @details source location is stored in a `static constexpr` table of call sites, one per log level
  */
 // clang-format off
 #define AW_LOG_BASE(logger, level, msg) \
@@ -61,16 +98,8 @@ std::string format_message(std::string_view fmt, const Args&... args)
     { \
         try \
         { \
-            aw_logger::LogEventWrap( \
-                std::make_shared<aw_logger::LogEvent>( \
-                    logger, \
-                    level, \
-                    aw_logger::LogEvent::LocalSourceLocation<std::string>( \
-                        msg, \
-                        std::source_location::current() \
-                    ) \
-                ) \
-            ); \
+            static constexpr aw_logger::CallSiteTable aw_call_sites(std::source_location::current()); \
+            logger->log(aw_call_sites.get(level), msg); \
         } catch (std::exception & ex) \
         { \
             std::cerr << ex.what() << "\n" << std::endl; \
@@ -81,9 +110,10 @@ std::string format_message(std::string_view fmt, const Args&... args)
 /***
  * @brief aw logger fmt macro definition with `std::format` support
  * @param logger logger instance
- * @param level input log level
- * @param fmt unformatted log message
+ * @param level input log level, either a constant expression or a runtime value
+ * @param fmt unformatted log message, MUST be a constant expression, e.g. string literal
  * @param ... variadic arguments
+ * @details format string is checked at compile time and pre-parsed ONCE into call site
  */
 // clang-format off
 #define AW_LOG_FMT_BASE(logger, level, fmt, ...) \
@@ -91,16 +121,11 @@ std::string format_message(std::string_view fmt, const Args&... args)
     { \
         try \
         { \
-            aw_logger::LogEventWrap( \
-                std::make_shared<aw_logger::LogEvent>( \
-                    logger, \
-                    level, \
-                    aw_logger::LogEvent::LocalSourceLocation<std::string>( \
-                        aw_logger::format_message(fmt, ##__VA_ARGS__), \
-                        std::source_location::current() \
-                    ) \
-                ) \
+            static constexpr aw_logger::FormatSpec aw_fmt_spec(fmt); \
+            static constexpr aw_logger::CallSiteTable aw_call_sites( \
+                std::source_location::current(), &aw_fmt_spec \
             ); \
+            logger->logFmt(aw_call_sites.get(level), fmt, ##__VA_ARGS__); \
         } catch (std::exception & ex) \
         { \
             std::cerr << ex.what() << "\n" << std::endl; \
@@ -108,34 +133,63 @@ std::string format_message(std::string_view fmt, const Args&... args)
     }
 // clang-format on
 
-#define AW_LOG_DEBUG(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::DEBUG, msg)
-
-#define AW_LOG_INFO(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::INFO, msg)
-
-#define AW_LOG_NOTICE(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::NOTICE, msg)
-
-#define AW_LOG_WARN(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::WARN, msg)
-
-#define AW_LOG_ERROR(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::ERROR, msg)
-
-#define AW_LOG_FATAL(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::FATAL, msg)
-
-#define AW_LOG_FMT_DEBUG(logger, fmt, ...) \
-    AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::DEBUG, fmt, ##__VA_ARGS__)
-
-#define AW_LOG_FMT_INFO(logger, fmt, ...) \
-    AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::INFO, fmt, ##__VA_ARGS__)
-
-#define AW_LOG_FMT_NOTICE(logger, fmt, ...) \
-    AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::NOTICE, fmt, ##__VA_ARGS__)
-
-#define AW_LOG_FMT_WARN(logger, fmt, ...) \
-    AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::WARN, fmt, ##__VA_ARGS__)
-
-#define AW_LOG_FMT_ERROR(logger, fmt, ...) \
-    AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::ERROR, fmt, ##__VA_ARGS__)
-
-#define AW_LOG_FMT_FATAL(logger, fmt, ...) \
-    AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::FATAL, fmt, ##__VA_ARGS__)
+/***
+ * @brief expansion of `AW_LOG_*` macros below `AW_LOGGER_ACTIVE_LEVEL`
+ */
+#define AW_LOG_DISABLED() static_cast<void>(0)
+
+#if AW_LOGGER_ACTIVE_LEVEL <= AW_LOGGER_LEVEL_DEBUG
+    #define AW_LOG_DEBUG(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::DEBUG, msg)
+    #define AW_LOG_FMT_DEBUG(logger, fmt, ...) \
+        AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::DEBUG, fmt, ##__VA_ARGS__)
+#else
+    #define AW_LOG_DEBUG(logger, msg) AW_LOG_DISABLED()
+    #define AW_LOG_FMT_DEBUG(logger, fmt, ...) AW_LOG_DISABLED()
+#endif
+
+#if AW_LOGGER_ACTIVE_LEVEL <= AW_LOGGER_LEVEL_INFO
+    #define AW_LOG_INFO(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::INFO, msg)
+    #define AW_LOG_FMT_INFO(logger, fmt, ...) \
+        AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::INFO, fmt, ##__VA_ARGS__)
+#else
+    #define AW_LOG_INFO(logger, msg) AW_LOG_DISABLED()
+    #define AW_LOG_FMT_INFO(logger, fmt, ...) AW_LOG_DISABLED()
+#endif
+
+#if AW_LOGGER_ACTIVE_LEVEL <= AW_LOGGER_LEVEL_NOTICE
+    #define AW_LOG_NOTICE(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::NOTICE, msg)
+    #define AW_LOG_FMT_NOTICE(logger, fmt, ...) \
+        AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::NOTICE, fmt, ##__VA_ARGS__)
+#else
+    #define AW_LOG_NOTICE(logger, msg) AW_LOG_DISABLED()
+    #define AW_LOG_FMT_NOTICE(logger, fmt, ...) AW_LOG_DISABLED()
+#endif
+
+#if AW_LOGGER_ACTIVE_LEVEL <= AW_LOGGER_LEVEL_WARN
+    #define AW_LOG_WARN(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::WARN, msg)
+    #define AW_LOG_FMT_WARN(logger, fmt, ...) \
+        AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::WARN, fmt, ##__VA_ARGS__)
+#else
+    #define AW_LOG_WARN(logger, msg) AW_LOG_DISABLED()
+    #define AW_LOG_FMT_WARN(logger, fmt, ...) AW_LOG_DISABLED()
+#endif
+
+#if AW_LOGGER_ACTIVE_LEVEL <= AW_LOGGER_LEVEL_ERROR
+    #define AW_LOG_ERROR(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::ERROR, msg)
+    #define AW_LOG_FMT_ERROR(logger, fmt, ...) \
+        AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::ERROR, fmt, ##__VA_ARGS__)
+#else
+    #define AW_LOG_ERROR(logger, msg) AW_LOG_DISABLED()
+    #define AW_LOG_FMT_ERROR(logger, fmt, ...) AW_LOG_DISABLED()
+#endif
+
+#if AW_LOGGER_ACTIVE_LEVEL <= AW_LOGGER_LEVEL_FATAL
+    #define AW_LOG_FATAL(logger, msg) AW_LOG_BASE(logger, aw_logger::LogLevel::level::FATAL, msg)
+    #define AW_LOG_FMT_FATAL(logger, fmt, ...) \
+        AW_LOG_FMT_BASE(logger, aw_logger::LogLevel::level::FATAL, fmt, ##__VA_ARGS__)
+#else
+    #define AW_LOG_FATAL(logger, msg) AW_LOG_DISABLED()
+    #define AW_LOG_FMT_FATAL(logger, fmt, ...) AW_LOG_DISABLED()
+#endif
 
 #endif //! LOG_MACRO_HPP
@@ -20,15 +20,22 @@
 #include <concepts>
 #include <condition_variable>
 #include <iostream>
-#include <list>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <source_location>
+#include <span>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 // aw_logger library
 #include "aw_logger/appender.hpp"
+#include "aw_logger/call_site.hpp"
+#include "aw_logger/clock.hpp"
+#include "aw_logger/format_spec.hpp"
 #include "aw_logger/log_event.hpp"
 #include "aw_logger/ring_buffer.hpp"
 
@@ -46,14 +53,18 @@
  */
 namespace aw_logger {
 class LogEvent;
+class EventPool;
 class BaseAppender;
 class ConsoleAppender;
+class AppenderPipeline;
 
 /***
  * @brief asynchronous logger class with a center ringbuffer
  * @note I'm strongly remind you that you should resize via test,
  * @note if the number consumers is lower than producer a lot, `capacity` should be lower than 512.
  * @note or `capacity` recommended to higher than 1024.
+ * @note `capacity` can be set via constructor, `LoggerManager::getLogger()`, `LoggerManager::setLoggerCapacity()`
+ * or `loggers` in `aw_logger_settings.json`.
  * @details
  * `std::enabled_shared_from_this` allow to manage the ONLY ONE share pointer of this class object
  *  via `std::shared_from_this`, which is CRTP
@@ -63,14 +74,37 @@ public:
     using Ptr = std::shared_ptr<Logger>;
     using ConstPtr = std::shared_ptr<const Logger>;
 
+    /***
+     * @brief overflow policy while ringbuffer is full
+     * @details
+     * DROP_NEWEST: discard the incoming log event and count it
+     * DROP_OLDEST: discard the oldest log event inside ringbuffer to make room for the incoming one, and count it
+     * BLOCK: spin for a bounded time, then park until ringbuffer has room
+     * GROW: move the incoming log event into an overflow list which is drained after ringbuffer,
+     * once overflow list reaches `getMaxOverflowSize()`, the incoming log event is discarded and counted
+     */
+    enum class overflowPolicy : size_t { DROP_NEWEST, DROP_OLDEST, BLOCK, GROW };
+
+    /***
+     * @brief default capacity of ringbuffer
+     */
+    static constexpr size_t kDefaultCapacity = 256;
+
+    /***
+     * @brief default max number of log events inside overflow list of `overflowPolicy::GROW`
+     */
+    static constexpr size_t kDefaultMaxOverflowSize = 65536;
+
     /***
      * @brief constructor
-     * @param lvl log level threshold for logger
      * @param name logger name
+     * @param lvl log level threshold for logger
+     * @param capacity capacity of ringbuffer, it will be rounded up to power of 2
      */
     explicit Logger(
         const std::string& name = "root",
-        const LogLevel::level lvl = LogLevel::level::DEBUG
+        const LogLevel::level lvl = LogLevel::level::DEBUG,
+        const size_t capacity = kDefaultCapacity
     );
 
     /***
@@ -89,6 +123,175 @@ public:
      */
     void submit(const std::shared_ptr<LogEvent>& event);
 
+    /***
+     * @brief make log event from event pool of logger
+     * @param level log level
+     * @param loc source location of call site
+     * @param msg log message
+     * @return log event, it goes back to event pool after worker thread has appended it
+     * @details it makes NO heap allocation in steady state, refer to `EventPool`
+     */
+    std::shared_ptr<LogEvent>
+    makeEvent(LogLevel::level level, const std::source_location& loc, std::string_view msg);
+
+    /***
+     * @brief make log event from event pool of logger, and format message into its message buffer
+     * @tparam Args variadic template parameter
+     * @param level log level
+     * @param loc source location of call site
+     * @param fmt format string
+     * @param args variadic template parameter
+     * @return log event, it goes back to event pool after worker thread has appended it
+     */
+    template<typename... Args>
+    std::shared_ptr<LogEvent> makeFmtEvent(
+        LogLevel::level level,
+        const std::source_location& loc,
+        std::string_view fmt,
+        const Args&... args
+    );
+
+    /***
+     * @brief log message
+     * @param level log level
+     * @param loc source location of call site
+     * @param msg log message
+     * @details log event is constructed from event pool, or in place inside ringbuffer cell in inline mode
+     */
+    void log(LogLevel::level level, const std::source_location& loc, std::string_view msg);
+
+    /***
+     * @brief log message of static call site
+     * @param site call site, it MUST have static storage duration
+     * @param msg log message
+     * @details it's what `AW_LOG_*` macros call
+     */
+    void log(const CallSite& site, std::string_view msg);
+
+    /***
+     * @brief log formatted message
+     * @tparam Args variadic template parameter
+     * @param level log level
+     * @param loc source location of call site
+     * @param fmt format string
+     * @param args variadic template parameter
+     */
+    template<typename... Args>
+    void logFmt(
+        LogLevel::level level,
+        const std::source_location& loc,
+        std::string_view fmt,
+        const Args&... args
+    );
+
+    /***
+     * @brief log formatted message with compile-time checked and pre-parsed format string
+     * @tparam Args variadic template parameter
+     * @param site call site with pre-parsed format string, it MUST have static storage duration
+     * @param fmt the same format string, which is checked against `args` at compile time
+     * @param args variadic template parameter
+     * @details it's what `AW_LOG_FMT_*` macros call, in deferred format mode, arguments are captured and
+     * formatted on worker thread
+     */
+    template<typename... Args>
+    void logFmt(const CallSite& site, std::format_string<const Args&...> fmt, const Args&... args);
+
+    /***
+     * @brief toggle deferred format mode, which moves formatting from caller thread to worker thread
+     * @param enable whether to enable deferred format mode
+     * @details
+     * format arguments are copied into log event, refer to `LogEvent::deferFormat()`.
+     * it ONLY works with `AW_LOG_FMT_*` macros, runtime format string is formatted immediately
+     * @note format error is NOT thrown to caller, the message of exception is logged instead
+     */
+    inline void setDeferredFormat(bool enable) noexcept
+    {
+        deferred_format_.store(enable, std::memory_order_release);
+    }
+
+    /***
+     * @brief get whether deferred format mode is enabled
+     * @return whether deferred format mode is enabled
+     */
+    inline bool isDeferredFormat() const noexcept
+    {
+        return deferred_format_.load(std::memory_order_acquire);
+    }
+
+    /***
+     * @brief set source of timestamp ticks captured by caller thread
+     * @param src source of timestamp ticks
+     * @details
+     * with `TickClock::source::STEADY` or `TickClock::source::TSC`, caller thread ONLY reads a raw tick counter,
+     * and worker thread converts it to wall-clock time via calibrated converter before appenders
+     */
+    inline void setClockSource(TickClock::source src) noexcept
+    {
+        clock_source_.store(src, std::memory_order_release);
+    }
+
+    /***
+     * @brief get source of timestamp ticks
+     * @return source of timestamp ticks
+     */
+    inline TickClock::source getClockSource() const noexcept
+    {
+        return clock_source_.load(std::memory_order_acquire);
+    }
+
+    /***
+     * @brief toggle inline mode, which constructs log events in place inside ringbuffer cells
+     * @param enable whether to enable inline mode
+     * @details
+     * in inline mode, log events skip event pool and control block of `std::shared_ptr`,
+     * and worker thread drains them in place for better cache locality.
+     * appenders get non-owning pointers which are valid ONLY during `append()` / `appendBatch()`.
+     * message buffer of each cell keeps its capacity, so oversized messages spill to heap ONLY while warming up
+     * @note
+     * it takes effect when this logger has its own appenders, otherwise log events follow mode of root logger.
+     * `overflowPolicy::DROP_OLDEST` behaves like `overflowPolicy::DROP_NEWEST` in inline mode,
+     * since log events being appended in place can't be evicted.
+     * log events submitted while toggling may be appended out of order
+     */
+    void setInlineEvents(bool enable);
+
+    /***
+     * @brief get whether inline mode is enabled
+     * @return whether inline mode is enabled
+     */
+    inline bool isInlineEvents() const noexcept
+    {
+        return inline_events_.load(std::memory_order_acquire);
+    }
+
+    /***
+     * @brief toggle appender pipeline, which formats on format threads and writes on I/O thread of each appender
+     * @param enable whether to enable appender pipeline
+     * @param format_thread_num number of format threads besides worker thread
+     * @param queue_capacity max number of pre-formatted buffers inside queue of each appender
+     * @details
+     * worker thread ONLY drains log events and waits for them to be formatted, then each appender consumes
+     * pre-formatted bytes on its own I/O thread, so a slow appender no longer stalls the others.
+     * queue of each appender applies the same overflow policy as ringbuffer, refer to `AppenderPipeline`
+     * @note
+     * it takes effect when this logger has its own appenders.
+     * log events submitted while toggling may be appended out of order
+     */
+    void setAppenderPipeline(
+        bool enable,
+        size_t format_thread_num = 1,
+        size_t queue_capacity = 256
+    );
+
+    /***
+     * @brief get whether appender pipeline is enabled
+     * @return whether appender pipeline is enabled
+     */
+    inline bool isAppenderPipeline() const noexcept
+    {
+        return has_pipeline_.load(std::memory_order_acquire);
+    }
+
     /***
      * @brief set log level threshold for logger
      * @param thres log level threshold for logger
@@ -107,6 +310,69 @@ public:
         return threshold_level_.load(std::memory_order_acquire);
     }
 
+    /***
+     * @brief get capacity of ringbuffer
+     * @return capacity of ringbuffer
+     */
+    inline size_t getCapacity() const noexcept
+    {
+        return rb_.getCapacity();
+    }
+
+    /***
+     * @brief set overflow policy while ringbuffer is full
+     * @param policy overflow policy
+     */
+    void setOverflowPolicy(overflowPolicy policy)
+    {
+        overflow_policy_.store(policy, std::memory_order_release);
+    }
+
+    /***
+     * @brief get overflow policy while ringbuffer is full
+     * @return overflow policy
+     */
+    inline overflowPolicy getOverflowPolicy() const noexcept
+    {
+        return overflow_policy_.load(std::memory_order_acquire);
+    }
+
+    /***
+     * @brief set max number of log events inside overflow list of `overflowPolicy::GROW`
+     * @param size max number of log events, so that a stalled appender can NOT grow memory without limit
+     */
+    void setMaxOverflowSize(size_t size)
+    {
+        max_overflow_size_.store(size, std::memory_order_relaxed);
+    }
+
+    /***
+     * @brief get max number of log events inside overflow list of `overflowPolicy::GROW`
+     * @return max number of log events
+     */
+    inline size_t getMaxOverflowSize() const noexcept
+    {
+        return max_overflow_size_.load(std::memory_order_relaxed);
+    }
+
+    /***
+     * @brief get number of log events dropped by overflow policy
+     * @return number of dropped log events before they reach appenders,
+     * the ones dropped by queues of appender pipeline are counted per appender
+     */
+    inline size_t getDroppedCount() const noexcept
+    {
+        return dropped_count_.load(std::memory_order_relaxed);
+    }
+
+    /***
+     * @brief get number of log events dropped by queue of appender inside appender pipeline
+     * @param appender appender of this logger
+     * @return number of dropped log events, 0 if appender pipeline is disabled
+     * @note count restarts once appender pipeline is set again
+     */
+    size_t getDroppedCount(const std::shared_ptr<BaseAppender>& appender) const;
+
     /***
      * @brief set(bind) root logger
      * @param root_logger root logger
@@ -158,6 +424,16 @@ public:
         return name_;
     }
 
+    /***
+     * @brief get view of logger name without copy
+     * @return current logger name
+     * @note name is set ONLY by constructor, so it needs no lock
+     */
+    std::string_view getNameView() const noexcept
+    {
+        return name_;
+    }
+
 private:
     /***
      * @brief binded root logger
@@ -166,8 +442,57 @@ private:
 
     /***
      * @brief log event ringbuffer
+     * @details worker thread is the ONLY consumer, so it uses multi-producer single-consumer policy
+     */
+    MPSCRingBuffer<std::shared_ptr<LogEvent>> rb_;
+
+    /***
+     * @brief pool of log events
+     * @details its capacity is twice of ringbuffer, which covers log events in ringbuffer and in a drained batch
+     */
+    std::shared_ptr<EventPool> event_pool_;
+
+    /***
+     * @brief ringbuffer of log events constructed in place, created ONCE while inline mode is enabled
      */
-    RingBuffer<std::shared_ptr<LogEvent>> rb_;
+    std::unique_ptr<MPSCRingBuffer<LogEvent>> inline_rb_;
+
+    /***
+     * @brief flag to indicate whether inline mode is enabled
+     */
+    std::atomic<bool> inline_events_;
+
+    /***
+     * @brief flag to indicate whether `inline_rb_` has been created
+     * @details `inline_rb_` is never destroyed until logger is destroyed, so worker thread can drain it safely
+     */
+    std::atomic<bool> has_inline_rb_;
+
+    /***
+     * @brief flag to create `inline_rb_` ONLY ONCE
+     */
+    std::once_flag inline_flag_;
+
+    /***
+     * @brief flag to indicate whether deferred format mode is enabled
+     */
+    std::atomic<bool> deferred_format_;
+
+    /***
+     * @brief source of timestamp ticks
+     */
+    std::atomic<TickClock::source> clock_source_;
+
+    /***
+     * @brief converter of steady clock ticks, ONLY accessed by worker thread
+     */
+    TickConverter steady_converter_;
+
+    /***
+     * @brief converter of cycle counter ticks, created at the first log event with such ticks,
+     * ONLY accessed by worker thread
+     */
+    std::unique_ptr<TickConverter> tsc_converter_;
 
     /***
      * @brief worker thread to pop out log message from ringbuffer to appenders
@@ -188,6 +513,96 @@ private:
      */
     std::atomic<bool> running_;
 
+    /***
+     * @brief flag to indicate whether worker thread is handing a drained batch to appenders
+     * @details ringbuffer is already empty at this moment, `flush()` MUST wait for it as well
+     */
+    std::atomic<bool> draining_;
+
+    /***
+     * @brief max number of log events drained from ringbuffer in one batch
+     */
+    static constexpr size_t kMaxBatchSize = 128;
+
+    /***
+     * @brief number of spin rounds before a thread parks
+     * @details used by blocked producers in `overflowPolicy::BLOCK` and by idle worker thread
+     */
+    static constexpr size_t kMaxSpinNum = 64;
+
+    /***
+     * @brief flag to indicate whether worker thread is parked on `cv_`
+     * @details producers notify worker thread ONLY when it's set, so hot path of `submit()` is free of mutex
+     * and futex syscall while worker thread is busy or spinning
+     */
+    std::atomic<bool> sleeping_;
+
+    /***
+     * @brief overflow policy while ringbuffer is full
+     */
+    std::atomic<overflowPolicy> overflow_policy_;
+
+    /***
+     * @brief number of log events dropped by overflow policy
+     */
+    std::atomic<size_t> dropped_count_;
+
+    /***
+     * @brief mutex to make consumer of ringbuffer exclusive
+     * @details
+     * `rb_` is single-consumer, so producers which evict the oldest log event in `overflowPolicy::DROP_OLDEST`
+     * MUST take turns with worker thread, worker thread takes it ONLY while `evicting_num_` is NOT zero
+     */
+    std::mutex pop_mtx_;
+
+    /***
+     * @brief number of producers evicting the oldest log event in `overflowPolicy::DROP_OLDEST`
+     */
+    std::atomic<size_t> evicting_num_;
+
+    /***
+     * @brief flag to indicate whether worker thread is popping from ringbuffer without `pop_mtx_`
+     * @details evicting producers wait until it's cleared, together with `evicting_num_` it's a handshake
+     * which keeps consumer of ringbuffer exclusive
+     */
+    std::atomic<bool> unlocked_popping_;
+
+    /***
+     * @brief number of producers parked in `overflowPolicy::BLOCK`
+     */
+    std::atomic<size_t> blocked_num_;
+
+    /***
+     * @brief condition variable to wake up parked producers after worker thread drains ringbuffer
+     */
+    std::condition_variable space_cv_;
+
+    /***
+     * @brief mutex to manage `space_cv_`
+     */
+    std::mutex space_mtx_;
+
+    /***
+     * @brief flag to indicate whether overflow list has log events
+     * @details while it's set, producers keep appending to overflow list in order to keep FIFO order
+     */
+    std::atomic<bool> has_overflow_;
+
+    /***
+     * @brief overflow list of log events in `overflowPolicy::GROW`
+     */
+    std::vector<std::shared_ptr<LogEvent>> overflow_list_;
+
+    /***
+     * @brief max number of log events inside overflow list
+     */
+    std::atomic<size_t> max_overflow_size_;
+
+    /***
+     * @brief mutex to protect overflow list
+     */
+    std::mutex overflow_mtx_;
+
     /***
      * @brief start flag to ensure to start named logger ONLY ONCE
      */
@@ -222,15 +637,145 @@ private:
     mutable std::shared_mutex rw_mtx_;
 
     /***
-     * @brief list of appenders
+     * @brief immutable snapshot of appenders
+     * @param version_ version of snapshot, increased each time appenders are changed
+     * @param appenders_ appenders
+     */
+    struct appender_snapshot_t {
+        uint64_t version_ = 0;
+        std::vector<std::shared_ptr<BaseAppender>> appenders_;
+    };
+
+    /***
+     * @brief snapshot of appenders, replaced as a whole under unique lock of `rw_mtx_`
+     * @details log calls and worker thread read it without lock
+     */
+    std::atomic<std::shared_ptr<const appender_snapshot_t>> appenders_;
+
+    /***
+     * @brief version of the latest snapshot of appenders
+     * @details it's stored after snapshot, so worker thread reloads snapshot ONLY if version changes
+     */
+    std::atomic<uint64_t> appenders_version_;
+
+    /***
+     * @brief whether the latest snapshot of appenders is NOT empty, checked by each log call
+     */
+    std::atomic<bool> has_appenders_;
+
+    /***
+     * @brief snapshot of appenders cached by worker thread, ONLY accessed by worker thread
+     */
+    std::shared_ptr<const appender_snapshot_t> worker_appenders_;
+
+    /***
+     * @brief publish new snapshot of appenders
+     * @param appenders appenders of new snapshot
+     * @note caller MUST hold unique lock of `rw_mtx_`
+     */
+    void publishAppenders(std::vector<std::shared_ptr<BaseAppender>> appenders);
+
+    /***
+     * @brief get the latest snapshot of appenders
+     * @return snapshot of appenders
      */
-    std::list<std::shared_ptr<BaseAppender>> appenders_;
+    std::shared_ptr<const appender_snapshot_t> getAppendersSnapshot() const noexcept
+    {
+        return appenders_.load(std::memory_order_acquire);
+    }
+
+    /***
+     * @brief appender pipeline, `nullptr` if it's disabled
+     * @details worker thread loads it once per batch, so it's replaced without lock
+     */
+    std::atomic<std::shared_ptr<AppenderPipeline>> pipeline_;
+
+    /***
+     * @brief whether appender pipeline is enabled, checked before loading `pipeline_`
+     */
+    std::atomic<bool> has_pipeline_;
 
     /***
      * @brief logger name
      */
     std::string name_;
 
+    /***
+     * @brief enqueue log event into ringbuffer within overflow policy
+     * @param event log event
+     * @return whether the log event is enqueued
+     */
+    bool enqueue(const std::shared_ptr<LogEvent>& event);
+
+    /***
+     * @brief route log call to the logger which owns appenders, and enqueue log event there
+     * @tparam MsgFn callable type, like `void(LogEvent&)`
+     * @param origin logger which the log call is made on
+     * @param site call site with static storage duration
+     * @param fill_msg callable to fill message of log event
+     */
+    template<typename MsgFn>
+    void emit(const Logger::Ptr& origin, const CallSite& site, const MsgFn& fill_msg);
+
+    /***
+     * @brief construct log event in place inside `inline_rb_` according to overflow policy
+     * @tparam MsgFn callable type, like `void(LogEvent&)`
+     * @param origin logger which the log call is made on
+     * @param site call site with static storage duration
+     * @param fill_msg callable to fill message of log event
+     * @return whether log event is enqueued
+     */
+    template<typename MsgFn>
+    bool enqueueInline(const Logger::Ptr& origin, const CallSite& site, const MsgFn& fill_msg);
+
+    /***
+     * @brief retry to push until success or worker thread stops, for `overflowPolicy::BLOCK`
+     * @tparam TryFn callable type, like `bool()`
+     * @tparam RoomFn callable type, like `bool()`
+     * @param try_push callable to try to push once
+     * @param has_room callable to check whether ringbuffer has room, as predicate while parking
+     * @return whether log event is pushed
+     */
+    template<typename TryFn, typename RoomFn>
+    bool blockingPush(TryFn&& try_push, RoomFn&& has_room);
+
+    /***
+     * @brief move log event into overflow list, for `overflowPolicy::GROW`
+     * @param event log event
+     * @return whether log event is moved, false if overflow list is full
+     */
+    bool pushOverflow(const std::shared_ptr<LogEvent>& event);
+
+    /***
+     * @brief whether any log event is pending inside ringbuffers or overflow list
+     * @return whether any log event is pending
+     */
+    bool hasPendingEvents() const noexcept;
+
+    /***
+     * @brief wake up producers parked in `overflowPolicy::BLOCK` since ringbuffer has room now
+     */
+    void notifySpace();
+
+    /***
+     * @brief notify worker thread that new log events arrive
+     * @details it's a no-op unless worker thread is parked
+     */
+    void notifyWorker();
+
+    /***
+     * @brief hand a batch of log events to all the appenders
+     * @param events batch of log events
+     */
+    void dispatch(std::span<const std::shared_ptr<LogEvent>> events);
+
+    /***
+     * @brief convert raw timestamp ticks of log events to wall-clock time
+     * @param events batch of log events
+     * @note ONLY called by worker thread
+     */
+    void resolveTimestamps(std::span<const std::shared_ptr<LogEvent>> events);
+
     /***
      * @brief start to run worker thread
      */
@@ -276,9 +821,21 @@ public:
     /***
      * @brief get logger
      * @param name logger name
+     * @param capacity capacity of ringbuffer if logger is created by this call,
+     * 0 means the capacity preset via `setLoggerCapacity()` or settings, otherwise `Logger::kDefaultCapacity`
      * @return current logger
+     * @note capacity of an existing logger is NOT changed,
+     * throw `aw_logger::invalid_parameter` if capacity is specified for root logger, which is created from settings
+     */
+    Logger::Ptr getLogger(const std::string& name, size_t capacity = 0);
+
+    /***
+     * @brief pre-size ringbuffer of named logger before its first use
+     * @param name logger name
+     * @param capacity capacity of ringbuffer
+     * @note throw `aw_logger::invalid_parameter` if the logger has already been created
      */
-    Logger::Ptr getLogger(const std::string& name);
+    void setLoggerCapacity(const std::string& name, size_t capacity);
 
     /***
      * @brief initialize root logger for ONLY ONCE
@@ -297,6 +854,12 @@ private:
      */
     std::unordered_map<std::string, Logger::Ptr> loggers_map_;
 
+    /***
+     * @brief preset capacity of ringbuffer for named loggers
+     * @details {logger name: capacity of ringbuffer}
+     */
+    std::unordered_map<std::string, size_t> capacity_map_;
+
     /***
      * @brief read and write logger manager mutex
      */
@@ -311,6 +874,12 @@ private:
      * @brief destroy logger manager in RAII
      */
     void destroy();
+
+    /***
+     * @brief load preset capacity of loggers from setting
+     * @param file_name file name
+     */
+    void loadLoggerSettings(std::string_view file_name);
 };
 } // namespace aw_logger
 
@@ -0,0 +1,445 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+// C++ standard library
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// aw_logger library
+#include "aw_logger/appender.hpp"
+#include "aw_logger/log_event.hpp"
+#include "aw_logger/logger.hpp"
+
+/***
+ * @brief a low-latency, high-throughput and few-dependency logger for `AwakeLion Robot Lab` project
+ * @note fundamental structure is inspired by [sylar logger](https://github.com/sylar-yin/sylar) and implement is
+ * inspired by [log4j2](https://logging.apache.org/log4j/2.12.x/) and [minilog](https://github.com/archibate/minilog)
+ * @author jinhua "siyiovo" deng
+ */
+namespace aw_logger {
+/***
+ * @brief small pool of format threads, which runs indexed tasks together with the calling thread
+ * @details tasks of ONE run are picked up via an atomic counter, so it needs no queue of tasks
+ */
+class FormatPool {
+public:
+    /***
+     * @brief constructor
+     * @param thread_num number of format threads besides the calling thread, 0 means running in calling thread
+     */
+    explicit FormatPool(size_t thread_num);
+
+    /***
+     * @brief destructor, stop and join format threads
+     */
+    ~FormatPool();
+
+    FormatPool(const FormatPool&) = delete;
+    FormatPool& operator=(const FormatPool&) = delete;
+
+    /***
+     * @brief run tasks `[0, task_num)` and wait until all of them are done
+     * @tparam TaskFn callable type, like `void(size_t) noexcept`
+     * @param task_num number of tasks
+     * @param task callable to run task of index, it MUST NOT throw
+     * @note ONLY ONE thread is allowed to call it at a time
+     */
+    template<typename TaskFn>
+    void run(size_t task_num, const TaskFn& task);
+
+    /***
+     * @brief get number of format threads
+     * @return number of format threads besides the calling thread
+     */
+    inline size_t getThreadNum() const noexcept
+    {
+        return threads_.size();
+    }
+
+private:
+    /***
+     * @brief format threads
+     */
+    std::vector<std::thread> threads_;
+
+    /***
+     * @brief mutex to publish run and wait for format threads
+     */
+    std::mutex mtx_;
+
+    /***
+     * @brief condition variable to wake up format threads for a new run
+     */
+    std::condition_variable run_cv_;
+
+    /***
+     * @brief condition variable to wake up calling thread once format threads leave the run
+     */
+    std::condition_variable done_cv_;
+
+    /***
+     * @brief generation of run, increased by each run
+     */
+    uint64_t generation_ = 0;
+
+    /***
+     * @brief number of format threads inside the current run
+     */
+    size_t active_num_ = 0;
+
+    /***
+     * @brief flag to stop format threads
+     */
+    bool stopping_ = false;
+
+    /***
+     * @brief type-erased task of the current run
+     */
+    const void* task_ = nullptr;
+
+    /***
+     * @brief type-erased function to run task of index
+     */
+    void (*task_fn_)(const void* task, size_t index) = nullptr;
+
+    /***
+     * @brief number of tasks of the current run
+     */
+    size_t task_num_ = 0;
+
+    /***
+     * @brief index of the next task to be picked up
+     */
+    std::atomic<size_t> next_task_ { 0 };
+
+    /***
+     * @brief pick up and run tasks until all of them are picked up
+     * @param task type-erased task
+     * @param task_fn type-erased function to run task of index
+     * @param task_num number of tasks, 0 means the run has been done
+     */
+    void drainTasks(const void* task, void (*task_fn)(const void*, size_t), size_t task_num) noexcept;
+
+    /***
+     * @brief loop of format thread
+     */
+    void workerLoop();
+};
+
+/***
+ * @brief bounded queue of pre-formatted bytes with its own I/O thread for ONE appender
+ * @details
+ * buffers are recycled after written, so steady state makes NO heap allocation.
+ * I/O thread takes all the queued buffers at once, so that appender is able to gather them into ONE write.
+ * backpressure follows overflow policy of logger:
+ * DROP_NEWEST: discard the incoming buffer
+ * DROP_OLDEST: discard the oldest buffer inside queue
+ * BLOCK: wait until I/O thread makes room
+ * GROW: queue is unbounded
+ */
+class AppenderChannel {
+public:
+    /***
+     * @brief constructor
+     * @param appender appender whose `isFormattedWritable()` is true
+     * @param capacity max number of buffers inside queue
+     */
+    AppenderChannel(BaseAppender::Ptr appender, size_t capacity);
+
+    /***
+     * @brief destructor, write out buffers inside queue and join I/O thread
+     */
+    ~AppenderChannel();
+
+    AppenderChannel(const AppenderChannel&) = delete;
+    AppenderChannel& operator=(const AppenderChannel&) = delete;
+
+    /***
+     * @brief acquire an empty buffer, recycled one first
+     * @return empty buffer
+     */
+    std::string acquireBuffer();
+
+    /***
+     * @brief give back buffer which is NOT pushed
+     * @param buffer buffer
+     */
+    void recycleBuffer(std::string&& buffer);
+
+    /***
+     * @brief push pre-formatted buffer to queue within overflow policy
+     * @param buffer pre-formatted buffer
+     * @param event_num number of log events inside buffer
+     * @param policy overflow policy while queue is full
+     * @return number of log events dropped by overflow policy
+     */
+    size_t push(std::string&& buffer, size_t event_num, Logger::overflowPolicy policy);
+
+    /***
+     * @brief wait until all the buffers inside queue are written
+     */
+    void drain();
+
+    /***
+     * @brief get appender
+     * @return appender
+     */
+    inline const BaseAppender::Ptr& getAppender() const noexcept
+    {
+        return appender_;
+    }
+
+    /***
+     * @brief get number of log events dropped by overflow policy of queue
+     * @return number of dropped log events
+     */
+    inline size_t getDroppedNum() const noexcept
+    {
+        return dropped_num_.load(std::memory_order_relaxed);
+    }
+
+private:
+    /***
+     * @brief pre-formatted buffer inside queue
+     * @param bytes_ pre-formatted bytes
+     * @param event_num_ number of log events inside buffer
+     */
+    struct buffer_t {
+        std::string bytes_;
+        size_t event_num_;
+    };
+
+    /***
+     * @brief max number of recycled buffers
+     */
+    static constexpr size_t kMaxFreeNum = 64;
+
+    /***
+     * @brief max number of buffers handed to appender by ONE write
+     */
+    static constexpr size_t kMaxGatherNum = 64;
+
+    /***
+     * @brief appender
+     */
+    BaseAppender::Ptr appender_;
+
+    /***
+     * @brief max number of buffers inside queue
+     */
+    size_t capacity_;
+
+    /***
+     * @brief queue of pre-formatted buffers
+     */
+    std::deque<buffer_t> queue_;
+
+    /***
+     * @brief recycled buffers which keep their capacity
+     */
+    std::vector<std::string> free_buffers_;
+
+    /***
+     * @brief number of log events dropped by overflow policy of queue
+     */
+    std::atomic<size_t> dropped_num_ { 0 };
+
+    /***
+     * @brief flag to indicate whether I/O thread is writing a buffer popped out of queue
+     */
+    bool writing_ = false;
+
+    /***
+     * @brief flag to stop I/O thread
+     */
+    bool stopping_ = false;
+
+    /***
+     * @brief mutex to protect queue and recycled buffers
+     */
+    std::mutex mtx_;
+
+    /***
+     * @brief condition variable to wake up I/O thread
+     */
+    std::condition_variable data_cv_;
+
+    /***
+     * @brief condition variable to wake up producer in `overflowPolicy::BLOCK` and `drain()`
+     */
+    std::condition_variable space_cv_;
+
+    /***
+     * @brief I/O thread
+     */
+    std::thread io_thread_;
+
+    /***
+     * @brief loop of I/O thread
+     */
+    void ioLoop();
+};
+
+/***
+ * @brief optional backend pipeline of logger, which decouples appenders from each other
+ * @details
+ **************************************************************************
+ *  worker thread  ->  format threads  ->  channel queue  ->  I/O thread   *
+ *  (drain batch)      (bytes per chunk)   (per appender)    (per appender) *
+ **************************************************************************
+ * each batch is split into chunks, and each chunk is formatted for each appender by `FormatPool` in parallel.
+ * log events are ONLY touched while formatting, so they go back to logger once the batch is formatted,
+ * and a slow appender never blocks writes of the others unless its own queue applies backpressure.
+ * appenders which are NOT formatted writable are appended on worker thread as usual
+ */
+class AppenderPipeline {
+public:
+    using Ptr = std::shared_ptr<AppenderPipeline>;
+
+    /***
+     * @brief default number of format threads
+     */
+    static constexpr size_t kDefaultFormatThreadNum = 1;
+
+    /***
+     * @brief default max number of buffers inside queue of each appender
+     */
+    static constexpr size_t kDefaultQueueCapacity = 256;
+
+    /***
+     * @brief number of log events of each chunk
+     */
+    static constexpr size_t kChunkSize = 32;
+
+    /***
+     * @brief constructor
+     * @param format_thread_num number of format threads besides worker thread of logger
+     * @param queue_capacity max number of buffers inside queue of each appender
+     */
+    explicit AppenderPipeline(
+        size_t format_thread_num = kDefaultFormatThreadNum,
+        size_t queue_capacity = kDefaultQueueCapacity
+    );
+
+    /***
+     * @brief format a batch of log events and hand them to appenders
+     * @param appenders appenders of logger, it's used as key of channels
+     * @param events batch of log events
+     * @param policy overflow policy of queue of each appender
+     * @note
+     * ONLY called by worker thread of logger.
+     * log events dropped by queues are counted per appender, refer to `getDroppedCount()`
+     */
+    void dispatch(
+        const std::vector<BaseAppender::Ptr>& appenders,
+        std::span<const LogEvent::Ptr> events,
+        Logger::overflowPolicy policy
+    );
+
+    /***
+     * @brief follow appenders of logger without log events, so channels of removed appenders are released
+     * @param appenders appenders of logger
+     * @note ONLY called by worker thread of logger
+     */
+    void syncAppenders(const std::vector<BaseAppender::Ptr>& appenders);
+
+    /***
+     * @brief wait until queues of all appenders are written
+     */
+    void drain();
+
+    /***
+     * @brief get number of log events dropped by overflow policy of queue of appender
+     * @param appender appender
+     * @return number of dropped log events, 0 if appender has no queue in this pipeline
+     */
+    size_t getDroppedCount(const BaseAppender::Ptr& appender);
+
+    /***
+     * @brief get max number of buffers inside queue of each appender
+     * @return max number of buffers inside queue of each appender
+     */
+    inline size_t getQueueCapacity() const noexcept
+    {
+        return queue_capacity_;
+    }
+
+    /***
+     * @brief get number of format threads
+     * @return number of format threads besides worker thread of logger
+     */
+    inline size_t getFormatThreadNum() const noexcept
+    {
+        return pool_.getThreadNum();
+    }
+
+private:
+    /***
+     * @brief max number of buffers inside queue of each appender
+     */
+    size_t queue_capacity_;
+
+    /***
+     * @brief format threads
+     */
+    FormatPool pool_;
+
+    /***
+     * @brief channels of appenders, `nullptr` for appender which is NOT formatted writable
+     * @details it's in the same order as `appenders_`
+     */
+    std::vector<std::unique_ptr<AppenderChannel>> channels_;
+
+    /***
+     * @brief appenders which channels are created for
+     */
+    std::vector<BaseAppender::Ptr> appenders_;
+
+    /***
+     * @brief formatted buffers of the current batch, indexed by `channel * chunk_num + chunk`
+     */
+    std::vector<std::string> buffers_;
+
+    /***
+     * @brief number of formatted log events of each buffer
+     */
+    std::vector<size_t> event_nums_;
+
+    /***
+     * @brief mutex to protect channels, taken by worker thread once per batch
+     */
+    std::mutex channels_mtx_;
+
+    /***
+     * @brief create channels for new appenders, and destroy channels of removed ones
+     * @param appenders appenders of logger
+     * @note caller MUST hold `channels_mtx_`
+     */
+    void syncChannels(const std::vector<BaseAppender::Ptr>& appenders);
+};
+} // namespace aw_logger
+
+#endif //! PIPELINE_HPP
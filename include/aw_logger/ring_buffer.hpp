@@ -30,13 +30,25 @@
  * @author jinhua "siyiovo" deng
  */
 namespace aw_logger {
+/***
+ * @brief consumer policy of ring buffer
+ * @details
+ * MPMC: multi-producer multi-consumer, consumers claim cells via CAS operation on read index
+ * MPSC: multi-producer single-consumer, the ONLY consumer owns read index as a plain counter
+ */
+enum class rbPolicy : size_t { MPMC, MPSC };
+
 /***
  * @brief a lock-free MPMC ring buffer without `std::mutex` and mirror MSB but with CAS operation, support `std::allocator` to manage memory
  * @tparam DataT data type
  * @tparam Allocator allocator type
+ * @tparam Policy consumer policy, `rbPolicy::MPSC` MUST be popped from ONE thread at a time
  * @details inspired by [Vyukov​'​s MPMCQueue](https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue) and Linux kfifo
  */
-template<typename DataT, typename Allocator = std::allocator<DataT>>
+template<
+    typename DataT,
+    typename Allocator = std::allocator<DataT>,
+    rbPolicy Policy = rbPolicy::MPMC>
 class RingBuffer {
 public:
     using value_t = DataT;
@@ -62,12 +74,55 @@ public:
     template<typename U>
     bool push(U&& data);
 
+    /***
+     * @brief construct data in place inside a claimed cell
+     * @tparam Fn callable type, like `void(value_t&)`
+     * @param fn callable to fill data inside the cell
+     * @return whether data is emplaced, false means ring buffer is full
+     * @details
+     * claim a cell like `push()`, call `fn` on the data inside the cell, then commit the cell to consumer.
+     * cell is committed even if `fn` throws, so `fn` MUST leave data in a state that consumer can recognize
+     */
+    template<typename Fn>
+    bool emplace(Fn&& fn);
+
     /***
      * @brief pop out data from ring buffer, FIFO
      * @param data pop-out data
      */
     bool pop(value_t& data);
 
+    /***
+     * @brief pop out a contiguous range of ready data from ring buffer, FIFO
+     * @tparam OutputIt output iterator type, e.g. `std::back_insert_iterator`
+     * @param out output iterator to receive pop-out data
+     * @param max_n max number of data to be popped
+     * @return number of popped data, 0 means ring buffer is empty
+     * @details
+     * all the ready cells from read index are claimed by ONE update of `rIdx_`(CAS operation in `rbPolicy::MPMC`,
+     * plain store in `rbPolicy::MPSC`), so consumer pays the atomic cost once per batch instead of once per data
+     */
+    template<typename OutputIt>
+    size_t pop_bulk(OutputIt out, size_t max_n);
+
+    /***
+     * @brief peek a contiguous range of ready data in place without handing cells back to producers, FIFO
+     * @tparam OutputIt output iterator type which receives `value_t*`
+     * @param out output iterator to receive pointers to data inside cells
+     * @param max_n max number of data to be peeked
+     * @return number of peeked data, 0 means ring buffer is empty
+     * @note ONLY for `rbPolicy::MPSC`, peeked data stays valid until `release()`
+     */
+    template<typename OutputIt>
+    size_t peek_bulk(OutputIt out, size_t max_n);
+
+    /***
+     * @brief hand peeked cells back to producers
+     * @param n number of cells to be released, MUST NOT be greater than the return of last `peek_bulk()`
+     * @note ONLY for `rbPolicy::MPSC`
+     */
+    void release(size_t n);
+
     /***
      * @brief get capacity of ring buffer
      * @retval capacity of ring buffer
@@ -140,6 +195,7 @@ private:
     /***
      * @brief atomic read index
      * @details wIdx and rIdx in different cache line to avoid false sharing
+     * @note in `rbPolicy::MPSC`, it is only written by the consumer and published for `getSize()`
      */
     alignas(64) std::atomic<size_t> rIdx_;
 
@@ -179,6 +235,14 @@ private:
         return idx & mask_;
     }
 };
+
+/***
+ * @brief multi-producer single-consumer ring buffer, e.g. the ringbuffer drained by logger worker thread
+ * @tparam DataT data type
+ * @tparam Allocator allocator type
+ */
+template<typename DataT, typename Allocator = std::allocator<DataT>>
+using MPSCRingBuffer = RingBuffer<DataT, Allocator, rbPolicy::MPSC>;
 } // namespace aw_logger
 
 #endif //! RING_BUFFER_HPP
@@ -0,0 +1,94 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef TEST__ACTIVE_LEVEL_TEST_CPP
+#define TEST__ACTIVE_LEVEL_TEST_CPP
+
+/* strip logs below WARN in this translation unit, whatever the build option is */
+#undef AW_LOGGER_ACTIVE_LEVEL
+#define AW_LOGGER_ACTIVE_LEVEL AW_LOGGER_LEVEL_WARN
+
+// GoogleTest library
+#include <gtest/gtest.h>
+
+// C++ standard library
+#include <mutex>
+#include <string>
+#include <vector>
+
+// aw_logger library
+#include "aw_logger/aw_logger.hpp"
+
+/***
+ * @brief appender which records messages of log events
+ */
+class RecordAppender final: public aw_logger::BaseAppender {
+public:
+    void append(const aw_logger::LogEvent::Ptr& event) override
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        msgs_.push_back(event->getMsg());
+    }
+
+    void flush() override {}
+
+    std::vector<std::string> getMsgs()
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return msgs_;
+    }
+
+private:
+    std::mutex mtx_;
+    std::vector<std::string> msgs_;
+};
+
+/***
+ * @brief Test macros below `AW_LOGGER_ACTIVE_LEVEL` expand to nothing
+ */
+TEST(ActiveLevelTest, StripLowerLevels)
+{
+    auto logger = aw_logger::getLogger("active_level");
+    auto appender = std::make_shared<RecordAppender>();
+    logger->setAppender(appender);
+
+    int evaluated = 0;
+    const auto touch = [&evaluated]() {
+        evaluated++;
+        return std::string("evaluated");
+    };
+
+    // arguments of stripped macros are NOT evaluated
+    AW_LOG_DEBUG(logger, touch());
+    AW_LOG_INFO(logger, touch());
+    AW_LOG_NOTICE(logger, touch());
+    AW_LOG_FMT_DEBUG(logger, "{}", touch());
+    AW_LOG_FMT_INFO(logger, "{}", touch());
+    AW_LOG_FMT_NOTICE(logger, "{}", touch());
+    EXPECT_EQ(evaluated, 0);
+
+    // the rest levels are still logged
+    AW_LOG_WARN(logger, touch());
+    AW_LOG_FMT_ERROR(logger, "error {}", 1);
+    AW_LOG_FATAL(logger, "fatal");
+    logger->flush();
+    EXPECT_EQ(evaluated, 1);
+
+    const auto msgs = appender->getMsgs();
+    ASSERT_EQ(msgs.size(), 3);
+    EXPECT_EQ(msgs[0], "evaluated");
+    EXPECT_EQ(msgs[1], "error 1");
+    EXPECT_EQ(msgs[2], "fatal");
+}
+
+#endif //! TEST__ACTIVE_LEVEL_TEST_CPP
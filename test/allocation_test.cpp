@@ -0,0 +1,214 @@
+// Copyright 2025 siyiovo
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST__ALLOCATION_TEST_CPP
+#define TEST__ALLOCATION_TEST_CPP
+
+// GoogleTest library
+#include <gtest/gtest.h>
+
+// C++ standard library
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <vector>
+
+// aw_logger library
+#include "aw_logger/aw_logger.hpp"
+
+/***
+ * @brief counter of heap allocations made by current thread while counting is enabled
+ */
+static thread_local bool counting_enabled = false;
+static thread_local size_t allocation_count = 0;
+
+void* operator new(size_t size)
+{
+    if (counting_enabled)
+        allocation_count++;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+/* replaced operator new allocates by malloc(), but GCC does NOT see through the replacement */
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic pop
+#endif
+
+/***
+ * @brief RAII scope to count heap allocations made by current thread
+ */
+class AllocationCounter {
+public:
+    AllocationCounter()
+    {
+        allocation_count = 0;
+        counting_enabled = true;
+    }
+
+    ~AllocationCounter()
+    {
+        counting_enabled = false;
+    }
+
+    size_t count() const noexcept
+    {
+        return allocation_count;
+    }
+};
+
+/***
+ * @brief appender which discards log events
+ */
+class NullAppender final: public aw_logger::BaseAppender {
+public:
+    void append(const aw_logger::LogEvent::Ptr&) override {}
+
+    void flush() override {}
+};
+
+/***
+ * @brief count heap allocations of steady-state logging in caller thread
+ * @param logger logger with its own appender
+ */
+void expectNoAllocation(const aw_logger::Logger::Ptr& logger)
+{
+    const int ROUNDS = 10;
+    const int BURST_SIZE = 50;
+    const std::string long_msg(256, 'x');
+
+    const auto log_burst = [&]() {
+        for (int i = 0; i < BURST_SIZE; i++)
+        {
+            AW_LOG_INFO(logger, "steady state message");
+            AW_LOG_INFO(logger, long_msg);
+            AW_LOG_FMT_WARN(logger, "steady state {} {} {}", i, 3.14, long_msg);
+        }
+    };
+
+    // warm up: create pooled log events and grow their message buffers
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        log_burst();
+        logger->flush();
+    }
+
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        size_t allocations = 0;
+        {
+            AllocationCounter counter;
+            log_burst();
+            allocations = counter.count();
+        }
+        logger->flush();
+        EXPECT_EQ(allocations, 0) << "round " << r;
+    }
+    EXPECT_EQ(logger->getDroppedCount(), 0);
+}
+
+/***
+ * @brief Test steady-state logging path makes no heap allocation in caller thread
+ */
+TEST(AllocationTest, SteadyStateLogging)
+{
+    auto logger = aw_logger::getLogger("allocation_test");
+    logger->setAppender(std::make_shared<NullAppender>());
+    expectNoAllocation(logger);
+}
+
+/***
+ * @brief Test steady-state logging path in inline mode makes no heap allocation in caller thread
+ */
+TEST(AllocationTest, SteadyStateInlineLogging)
+{
+    auto logger = aw_logger::getLogger("allocation_inline_test");
+    logger->setInlineEvents(true);
+    logger->setAppender(std::make_shared<NullAppender>());
+    expectNoAllocation(logger);
+}
+
+/***
+ * @brief Test formatting log events into buffer of formatter and file appender makes no heap allocation
+ */
+TEST(AllocationTest, FormatIntoAppenderBuffer)
+{
+    const int ROUNDS = 10;
+    const int BATCH_SIZE = 50;
+
+    auto logger = aw_logger::getLogger("allocation_format_test");
+    std::vector<aw_logger::LogEvent::Ptr> events;
+    for (int i = 0; i < BATCH_SIZE; i++)
+    {
+        events.push_back(std::make_shared<aw_logger::LogEvent>(
+            logger,
+            aw_logger::LogLevel::level::INFO,
+            "formatted into appender buffer " + std::to_string(i)
+        ));
+    }
+
+    // formatter appends into caller-owned buffer
+    aw_logger::Formatter formatter(std::make_unique<aw_logger::ComponentFactory>());
+    std::string out;
+    out.reserve(64 * 1024);
+    formatter.formatTo(out, events.front());
+    {
+        AllocationCounter counter;
+        for (const auto& event: events)
+            formatter.formatTo(out, event);
+        EXPECT_EQ(counter.count(), 0);
+    }
+    std::string expected = formatter.formatEvent(events.front());
+    for (const auto& event: events)
+        expected += formatter.formatEvent(event);
+    EXPECT_EQ(out, expected);
+
+    // file appender formats into its own memory buffer, and flushes it while full
+    const auto log_path = std::filesystem::temp_directory_path() / "aw_logger_allocation_test.log";
+    auto file_appender = std::make_shared<aw_logger::FileAppender>(log_path.string(), true, 4096);
+    for (int r = 0; r < ROUNDS; r++)
+        file_appender->appendBatch(events);
+
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        size_t allocations = 0;
+        {
+            AllocationCounter counter;
+            file_appender->appendBatch(events);
+            allocations = counter.count();
+        }
+        EXPECT_EQ(allocations, 0) << "round " << r;
+    }
+
+    file_appender->flush();
+    EXPECT_GT(std::filesystem::file_size(log_path), 0);
+    std::filesystem::remove(log_path);
+}
+
+#endif //! TEST__ALLOCATION_TEST_CPP
@@ -18,8 +18,22 @@
 // GoogleTest library
 #include <gtest/gtest.h>
 
+// Linux library
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 // C++ standard library
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <latch>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -93,6 +107,362 @@ TEST(HelloAWLogger, HCall)
     SUCCEED();
 }
 
+/***
+ * @brief Test batch pop of ringbuffer
+ */
+TEST(HelloAWLogger, RingBufferPopBulk)
+{
+    aw_logger::RingBuffer<int> rb(16);
+
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_TRUE(rb.push(i));
+    }
+
+    // pop part of ready data, FIFO order should be kept
+    std::vector<int> out;
+    EXPECT_EQ(rb.pop_bulk(std::back_inserter(out), 4), 4);
+    EXPECT_EQ(out, (std::vector<int> { 0, 1, 2, 3 }));
+
+    // pop the rest, `max_n` larger than ready data
+    out.clear();
+    EXPECT_EQ(rb.pop_bulk(std::back_inserter(out), 64), 6);
+    EXPECT_EQ(out.front(), 4);
+    EXPECT_EQ(out.back(), 9);
+
+    // ringbuffer is empty now
+    EXPECT_EQ(rb.pop_bulk(std::back_inserter(out), 64), 0);
+    EXPECT_EQ(rb.getSize(), 0);
+}
+
+/***
+ * @brief Test in-place construction and consumption of ringbuffer
+ */
+TEST(HelloAWLogger, RingBufferInPlace)
+{
+    aw_logger::MPSCRingBuffer<std::string> rb(4);
+
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(rb.emplace([i](std::string& data) { data.assign(i + 1, 'a'); }));
+    }
+    // ringbuffer is full
+    EXPECT_FALSE(rb.emplace([](std::string& data) { data = "full"; }));
+
+    // cell is committed even if filling throws
+    std::string* first = nullptr;
+    {
+        std::vector<std::string*> cells;
+        EXPECT_EQ(rb.peek_bulk(std::back_inserter(cells), 2), 2);
+        EXPECT_EQ(*cells[0], "a");
+        EXPECT_EQ(*cells[1], "aa");
+        first = cells[0];
+
+        // peeked cells are NOT handed back until released
+        EXPECT_EQ(rb.getSize(), 4);
+        rb.release(2);
+        EXPECT_EQ(rb.getSize(), 2);
+    }
+    EXPECT_THROW(
+        rb.emplace([](std::string& data) {
+            data = "partial";
+            throw std::runtime_error("fill failed");
+        }),
+        std::runtime_error
+    );
+
+    std::vector<std::string*> cells;
+    EXPECT_EQ(rb.peek_bulk(std::back_inserter(cells), 64), 3);
+    EXPECT_EQ(*cells[2], "partial");
+    // data is consumed in place, cell is reused after wrap-around
+    EXPECT_EQ(cells[2], first);
+    rb.release(3);
+    EXPECT_EQ(rb.getSize(), 0);
+}
+
+/***
+ * @brief slow appender which records messages, for overflow tests
+ */
+class SlowRecordAppender final: public aw_logger::BaseAppender {
+public:
+    /***
+     * @param gate optional latch which blocks appending until it's counted down
+     */
+    explicit SlowRecordAppender(std::latch* gate = nullptr): gate_(gate) {}
+
+    void append(const aw_logger::LogEvent::Ptr& event) override
+    {
+        if (gate_ != nullptr)
+            gate_->wait();
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+        std::lock_guard<std::mutex> lk(mtx_);
+        msgs_.emplace_back(event->getMsg());
+    }
+
+    void flush() override {}
+
+    std::vector<std::string> getMsgs()
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return msgs_;
+    }
+
+private:
+    std::latch* gate_;
+    std::mutex mtx_;
+    std::vector<std::string> msgs_;
+};
+
+/***
+ * @brief Test overflow policies while ringbuffer is full
+ */
+TEST(HelloAWLogger, OverflowPolicy)
+{
+    using policy_t = aw_logger::Logger::overflowPolicy;
+    const int ITERATIONS = 2000;
+
+    /* gated appender blocks worker thread until all the log events are pushed, so ringbuffer surely overflows */
+    const auto run = [ITERATIONS](const std::string& name, policy_t policy, bool gated) {
+        std::latch gate(1);
+        auto logger = aw_logger::getLogger(name);
+        auto appender = std::make_shared<SlowRecordAppender>(gated ? &gate : nullptr);
+        logger->setOverflowPolicy(policy);
+        logger->setAppender(appender);
+        EXPECT_EQ(logger->getOverflowPolicy(), policy);
+
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            AW_LOG_FMT_INFO(logger, "overflow {}", i);
+        }
+        gate.count_down();
+        logger->flush();
+        logger->clearAppenders();
+        return std::make_pair(appender->getMsgs(), logger->getDroppedCount());
+    };
+
+    // drop newest: lost events are counted
+    {
+        auto [msgs, dropped] = run("overflow_drop_newest", policy_t::DROP_NEWEST, true);
+        EXPECT_GT(dropped, 0);
+        EXPECT_EQ(msgs.size() + dropped, ITERATIONS);
+        EXPECT_EQ(msgs.front(), "overflow 0");
+    }
+
+    // drop oldest: the newest event always survives
+    {
+        auto [msgs, dropped] = run("overflow_drop_oldest", policy_t::DROP_OLDEST, true);
+        EXPECT_GT(dropped, 0);
+        EXPECT_EQ(msgs.size() + dropped, ITERATIONS);
+        EXPECT_EQ(msgs.back(), "overflow " + std::to_string(ITERATIONS - 1));
+    }
+
+    // block and grow: nothing is lost and FIFO order is kept
+    for (auto policy: { policy_t::BLOCK, policy_t::GROW })
+    {
+        auto [msgs, dropped] =
+            run(policy == policy_t::BLOCK ? "overflow_block" : "overflow_grow", policy, false);
+        EXPECT_EQ(dropped, 0);
+        ASSERT_EQ(msgs.size(), ITERATIONS);
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            EXPECT_EQ(msgs[i], "overflow " + std::to_string(i));
+        }
+    }
+
+    // grow with a full overflow list: the incoming events are dropped and FIFO order is kept
+    {
+        aw_logger::getLogger("overflow_grow_capped")->setMaxOverflowSize(100);
+        auto [msgs, dropped] = run("overflow_grow_capped", policy_t::GROW, true);
+        EXPECT_GT(dropped, 0);
+        EXPECT_EQ(msgs.size() + dropped, ITERATIONS);
+        EXPECT_TRUE(std::is_sorted(msgs.begin(), msgs.end(), [](const auto& lhs, const auto& rhs) {
+            return std::stoi(lhs.substr(9)) < std::stoi(rhs.substr(9));
+        }));
+    }
+}
+
+/***
+ * @brief Test log events constructed in place inside ringbuffer cells
+ */
+TEST(HelloAWLogger, InlineEvents)
+{
+    const int ITERATIONS = 1000;
+    const std::string long_msg(100, 'x');
+
+    auto logger = aw_logger::getLogger("inline_events");
+    auto appender = std::make_shared<SlowRecordAppender>();
+    logger->setInlineEvents(true);
+    logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+    logger->setAppender(appender);
+    EXPECT_TRUE(logger->isInlineEvents());
+
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        if (i % 2 == 0)
+        {
+            AW_LOG_FMT_INFO(logger, "inline {}", i);
+        }
+        else
+        {
+            AW_LOG_INFO(logger, long_msg);
+        }
+    }
+    logger->flush();
+
+    // nothing is lost and FIFO order is kept, including oversized messages
+    auto msgs = appender->getMsgs();
+    ASSERT_EQ(msgs.size(), ITERATIONS);
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        EXPECT_EQ(msgs[i], (i % 2 == 0) ? "inline " + std::to_string(i) : long_msg);
+    }
+    EXPECT_EQ(logger->getDroppedCount(), 0);
+
+    // back to pooled log events
+    logger->setInlineEvents(false);
+    AW_LOG_INFO(logger, "pooled");
+    logger->flush();
+    EXPECT_EQ(appender->getMsgs().back(), "pooled");
+}
+
+/***
+ * @brief Test deferred format which captures arguments and formats on worker thread
+ */
+TEST(HelloAWLogger, DeferredFormat)
+{
+    auto logger = aw_logger::getLogger("deferred_format");
+    auto appender = std::make_shared<SlowRecordAppender>();
+    logger->setDeferredFormat(true);
+    logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+    logger->setAppender(appender);
+    EXPECT_TRUE(logger->isDeferredFormat());
+
+    // string-like arguments are copied, so they can die before worker thread formats them
+    for (int i = 0; i < 100; i++)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "buffer-%d", i);
+        std::string str = "string-" + std::to_string(i) + std::string(32, '!');
+        std::string_view view = str;
+        AW_LOG_FMT_INFO(logger, "{} {} {} {} {}", i, 0.5, buffer, str, view.substr(0, 8));
+        str.assign(str.size(), '?');
+        std::snprintf(buffer, sizeof(buffer), "overwritten");
+    }
+
+    // runtime format string is formatted immediately
+    const std::string runtime_fmt = "runtime {}";
+    logger->logFmt(aw_logger::LogLevel::level::INFO, std::source_location::current(), runtime_fmt, 42);
+    logger->flush();
+
+    auto msgs = appender->getMsgs();
+    ASSERT_EQ(msgs.size(), 101);
+    for (int i = 0; i < 100; i++)
+    {
+        const std::string str = "string-" + std::to_string(i) + std::string(32, '!');
+        EXPECT_EQ(
+            msgs[i],
+            std::to_string(i) + " 0.5 buffer-" + std::to_string(i) + " " + str + " "
+                + str.substr(0, 8)
+        );
+    }
+    EXPECT_EQ(msgs[100], "runtime 42");
+}
+
+/***
+ * @brief Test pre-parsed format string of `AW_LOG_FMT_*` macros
+ */
+TEST(HelloAWLogger, FormatSpec)
+{
+    const auto format = [](const aw_logger::FormatSpec& spec, const auto&... args) {
+        std::string out;
+        spec.formatTo(out, args...);
+        return out;
+    };
+
+    static constexpr aw_logger::FormatSpec plain("no replacement field");
+    EXPECT_TRUE(plain.isParsed());
+    EXPECT_EQ(plain.getSize(), 1);
+    EXPECT_EQ(format(plain), "no replacement field");
+
+    static constexpr aw_logger::FormatSpec automatic("x={}, y={}, name={}.");
+    EXPECT_TRUE(automatic.isParsed());
+    EXPECT_EQ(automatic.getSize(), 7);
+    EXPECT_EQ(format(automatic, 1, 2.5, std::string("awakelion")), "x=1, y=2.5, name=awakelion.");
+
+    static constexpr aw_logger::FormatSpec manual("{1} before {0}");
+    EXPECT_TRUE(manual.isParsed());
+    EXPECT_EQ(format(manual, "a", "b"), "b before a");
+
+    static constexpr aw_logger::FormatSpec escaped("{{{}}} {{}}");
+    EXPECT_TRUE(escaped.isParsed());
+    EXPECT_EQ(format(escaped, 7), "{7} {}");
+
+    static constexpr aw_logger::FormatSpec with_spec("pi = {:.2f}, hex = {:#x}");
+    EXPECT_TRUE(with_spec.isParsed());
+    EXPECT_EQ(format(with_spec, 3.14159, 255), std::format("pi = {:.2f}, hex = {:#x}", 3.14159, 255));
+
+    // spec is parsed ONCE per thread, and the parsed formatter is reused by the later calls
+    static constexpr aw_logger::FormatSpec aligned("[{:>6}|{:<4}]");
+    const auto aligned_expected = std::format("[{:>6}|{:<4}]", 42, "ab");
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(format(aligned, 42, "ab"), aligned_expected);
+    }
+    std::thread([&]() { EXPECT_EQ(format(aligned, 42, "ab"), aligned_expected); }).join();
+
+    // nested replacement field is NOT pre-parsed, but still formatted
+    static constexpr aw_logger::FormatSpec nested("[{:>{}}]");
+    EXPECT_FALSE(nested.isParsed());
+    EXPECT_EQ(format(nested, 42, 5), std::format("[{:>{}}]", 42, 5));
+
+    // macros share the same call-site spec across calls
+    auto logger = aw_logger::getLogger("format_spec");
+    auto appender = std::make_shared<SlowRecordAppender>();
+    logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+    logger->setAppender(appender);
+    for (int i = 0; i < 10; i++)
+    {
+        AW_LOG_FMT_INFO(logger, "{{call}} {} of {}", i, 10);
+    }
+    logger->flush();
+
+    auto msgs = appender->getMsgs();
+    ASSERT_EQ(msgs.size(), 10);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(msgs[i], "{call} " + std::to_string(i) + " of 10");
+    }
+}
+
+/***
+ * @brief Test ringbuffer capacity of loggers
+ */
+TEST(HelloAWLogger, LoggerCapacity)
+{
+    // default capacity, or preset in settings
+    EXPECT_EQ(
+        aw_logger::getLogger("capacity_default")->getCapacity(),
+        aw_logger::Logger::kDefaultCapacity
+    );
+
+    // specified while created, rounded up to power of 2
+    EXPECT_EQ(aw_logger::getLogger("capacity_specified", 1000)->getCapacity(), 1024);
+    // existing logger is NOT resized
+    EXPECT_EQ(aw_logger::getLogger("capacity_specified", 4096)->getCapacity(), 1024);
+
+    // pre-size before first use
+    aw_logger::setLoggerCapacity("capacity_preset", 4096);
+    EXPECT_EQ(aw_logger::getLogger("capacity_preset")->getCapacity(), 4096);
+    EXPECT_THROW(
+        aw_logger::setLoggerCapacity("capacity_preset", 512),
+        aw_logger::invalid_parameter
+    );
+
+    // root logger is created from settings, its capacity can NOT be specified
+    EXPECT_THROW(aw_logger::getLogger("root", 1024), aw_logger::invalid_parameter);
+    EXPECT_EQ(aw_logger::getLogger("root"), aw_logger::getLogger());
+}
+
 /***
  * @brief Test multiple named loggers (non-root) with different outputs
  */
@@ -279,6 +649,1061 @@ TEST(HelloAWLogger, CustomPatternParsing)
     SUCCEED();
 }
 
+/***
+ * @brief Test compiled instructions of formatter output the same as string dispatch of components
+ */
+TEST(HelloAWLogger, FormatterInstructions)
+{
+    auto logger = aw_logger::getLogger("formatter_instructions");
+    const auto expect_same = [&logger](aw_logger::Formatter& formatter) {
+        for (auto level: { aw_logger::LogLevel::level::DEBUG,
+                           aw_logger::LogLevel::level::WARN,
+                           aw_logger::LogLevel::level::FATAL })
+        {
+            auto event = std::make_shared<aw_logger::LogEvent>(
+                logger,
+                level,
+                std::string("formatter {instructions}")
+            );
+            EXPECT_EQ(
+                formatter.formatEvent(event),
+                formatter.formatComponents(event, formatter.getRegisteredComponents())
+            );
+        }
+    };
+
+    // components from settings, including color
+    aw_logger::Formatter settings_formatter(std::make_unique<aw_logger::ComponentFactory>());
+    expect_same(settings_formatter);
+
+    // adjacent literal texts are merged into ONE text instruction, and source locations into ONE location
+    aw_logger::Formatter pattern_formatter(
+        std::make_unique<aw_logger::ComponentFactory>("=== %t [%p] (%f:%n:%l) <%i> -> %m ===")
+    );
+    expect_same(pattern_formatter);
+    const auto& instructions = pattern_formatter.getInstructions();
+    ASSERT_FALSE(instructions.empty());
+    EXPECT_EQ(instructions.front().op_, aw_logger::Formatter::opCode::TEXT);
+    EXPECT_EQ(pattern_formatter.getText(instructions.front()), "=== ");
+    const auto location_num =
+        std::count_if(instructions.begin(), instructions.end(), [](const auto& instruction) {
+            return instruction.op_ == aw_logger::Formatter::opCode::LOCATION;
+        });
+    EXPECT_EQ(location_num, 1);
+    for (size_t i = 1; i < instructions.size(); i++)
+    {
+        EXPECT_FALSE(
+            instructions[i - 1].op_ == aw_logger::Formatter::opCode::TEXT
+            && instructions[i].op_ == aw_logger::Formatter::opCode::TEXT
+        );
+    }
+
+    // factory can be replaced at runtime
+    pattern_formatter.setFactory(std::make_unique<aw_logger::ComponentFactory>("%m"));
+    ASSERT_EQ(pattern_formatter.getInstructions().size(), 1);
+    expect_same(pattern_formatter);
+}
+
+/***
+ * @brief Test timestamp with cached per-second prefix and configurable precision
+ */
+TEST(HelloAWLogger, TimestampPrecision)
+{
+    auto logger = aw_logger::getLogger("timestamp_precision");
+    auto event = std::make_shared<aw_logger::LogEvent>(
+        logger,
+        aw_logger::LogLevel::level::INFO,
+        std::string("timestamp")
+    );
+
+    // expected timestamp of log event with sub-second digits
+    const auto expected = [&event](size_t digits) {
+        using namespace std::chrono;
+        const auto local = event->getTimestamp();
+        const auto second = floor<seconds>(local);
+        auto sub_second = duration_cast<nanoseconds>(local - second).count();
+        for (size_t i = digits; i < 9; i++)
+            sub_second /= 10;
+        std::string fraction = std::to_string(sub_second);
+        fraction.insert(0, digits - fraction.size(), '0');
+        return std::format("[{:%F %T}", second) + "." + fraction + "]";
+    };
+
+    const auto make_formatter = [](std::string_view precision) {
+        auto factory = std::make_unique<aw_logger::ComponentFactory>("%t");
+        factory->registered_components_.front().second = precision;
+        return aw_logger::Formatter(std::move(factory));
+    };
+
+    for (const auto& [precision, digits]: { std::pair<std::string_view, size_t> { "ms", 3 },
+                                             std::pair<std::string_view, size_t> { "us", 6 },
+                                             std::pair<std::string_view, size_t> { "ns", 9 } })
+    {
+        auto formatter = make_formatter(precision);
+        const auto first = formatter.formatEvent(event);
+        EXPECT_EQ(first, expected(digits)) << precision;
+        // second call hits cached prefix
+        EXPECT_EQ(formatter.formatEvent(event), first) << precision;
+    }
+
+    // default precision is the same as plain `std::format` of timestamp
+    aw_logger::Formatter pattern_formatter(std::make_unique<aw_logger::ComponentFactory>("%t"));
+    EXPECT_EQ(pattern_formatter.formatEvent(event), std::format("[{}]", event->getTimestamp()));
+}
+
+/***
+ * @brief Test width, alignment and new conversions of pattern language
+ */
+TEST(HelloAWLogger, PatternEngine)
+{
+    auto logger = aw_logger::getLogger("pattern_engine");
+    const auto format = [&logger](std::string_view pattern, std::string msg = "msg") {
+        auto event = std::make_shared<aw_logger::LogEvent>(
+            logger,
+            aw_logger::LogLevel::level::INFO,
+            std::move(msg)
+        );
+        aw_logger::Formatter formatter(std::make_unique<aw_logger::ComponentFactory>(pattern));
+        // compiled instructions output the same as string dispatch of components except width
+        if (pattern.find_first_of("-=.0123456789") == std::string_view::npos)
+        {
+            EXPECT_EQ(
+                formatter.formatEvent(event),
+                formatter.formatComponents(event, formatter.getRegisteredComponents())
+            );
+        }
+        return formatter.formatEvent(event);
+    };
+
+    // width, alignment and truncation
+    EXPECT_EQ(format("%8p|"), "  [INFO]|");
+    EXPECT_EQ(format("%-8p|"), "[INFO]  |");
+    EXPECT_EQ(format("%=9p|"), " [INFO]  |");
+    EXPECT_EQ(format("%.4m|", "truncated"), "trun|");
+    EXPECT_EQ(format("%-6.4m|", "truncated"), "trun  |");
+    EXPECT_EQ(format("%2p|"), "[INFO]|");
+    // truncation backs off to boundary of UTF-8 code point
+    EXPECT_EQ(format("%.4m|", "a\u00e9\u00e9"), "a\u00e9|");
+    EXPECT_EQ(format("%.3m|", "\u4f60\u597d"), "\u4f60|");
+    EXPECT_EQ(format("%.2m|", "\u4f60\u597d"), "|");
+
+    // escaped and dangling percent are kept as text, unknown conversion is skipped
+    EXPECT_EQ(format("100%% %m %"), "100% msg %");
+    EXPECT_EQ(format("a%yb%-"), "ab%-");
+
+    // logger name and elapsed time
+    EXPECT_EQ(format("%c %m"), "[pattern_engine] msg");
+    const auto elapsed = format("%r");
+    EXPECT_TRUE(elapsed.starts_with("[") && elapsed.ends_with("ms]")) << elapsed;
+    EXPECT_NE(elapsed[1], '-') << elapsed;
+
+    // timestamp precision of pattern
+    const auto sub_second_digits = [](const std::string& timestamp) {
+        return timestamp.size() - timestamp.rfind('.') - 2;
+    };
+    EXPECT_EQ(sub_second_digits(format("%.3t")), 3u);
+    EXPECT_EQ(sub_second_digits(format("%.6t")), 6u);
+    EXPECT_THROW(format("%.4t"), aw_logger::invalid_parameter);
+
+    // thread name falls back to thread id, and it's captured by log event of caller thread
+    std::string unnamed, named;
+    std::thread([&]() {
+        unnamed = format("%T");
+        aw_logger::LogEvent::setThreadName("pattern-worker");
+        named = format("%-16T|");
+    }).join();
+    EXPECT_TRUE(unnamed.starts_with("[tid: ")) << unnamed;
+    EXPECT_EQ(named, "[pattern-worker]|");
+    EXPECT_EQ(format("%20T").size(), 20u);
+
+    // width of source location is NOT merged with adjacent one
+    aw_logger::Formatter loc_formatter(std::make_unique<aw_logger::ComponentFactory>("%-20f:%l"));
+    const auto& instructions = loc_formatter.getInstructions();
+    const auto location_num =
+        std::count_if(instructions.begin(), instructions.end(), [](const auto& instruction) {
+            return instruction.op_ == aw_logger::Formatter::opCode::LOCATION;
+        });
+    EXPECT_EQ(location_num, 2);
+}
+
+/***
+ * @brief Test calibrated converter from raw ticks to wall-clock time with synthetic samples
+ */
+TEST(HelloAWLogger, TickConverter)
+{
+    using namespace std::chrono;
+    const auto base_time = sys_time<nanoseconds>(seconds(1700000000));
+
+    // 2 ticks per nanosecond
+    aw_logger::TickConverter converter(
+        aw_logger::TickClock::source::STEADY,
+        { 1000, base_time },
+        0.5
+    );
+    EXPECT_EQ(converter.toSysTime(3000), base_time + nanoseconds(1000));
+    EXPECT_EQ(converter.toSysTime(0), base_time - nanoseconds(500));
+
+    // refit slope from base sample, then rebase on the new sample
+    const uint64_t ticks = 1000 + 2000000000;
+    converter.calibrate({ ticks, base_time + nanoseconds(1000000010) });
+    EXPECT_NEAR(converter.getNsPerTick(), 0.500000005, 1e-12);
+    EXPECT_EQ(converter.toSysTime(ticks), base_time + nanoseconds(1000000010));
+
+    // wall-clock time jumps, keep slope but follow the new time
+    converter.calibrate({ ticks + 2000, base_time + hours(1) });
+    EXPECT_NEAR(converter.getNsPerTick(), 0.500000005, 1e-12);
+    EXPECT_EQ(converter.toSysTime(ticks + 2000), base_time + hours(1));
+
+    // converters of real clocks, cycle counter falls back to steady clock if absent
+    for (auto src: { aw_logger::TickClock::source::STEADY, aw_logger::TickClock::source::TSC })
+    {
+        aw_logger::TickConverter real_converter(src);
+        EXPECT_GT(real_converter.getNsPerTick(), 0.0);
+        const auto converted = real_converter.toSysTime(aw_logger::TickClock::now(src));
+        EXPECT_LT(abs(converted - time_point_cast<nanoseconds>(system_clock::now())), milliseconds(10));
+    }
+}
+
+/***
+ * @brief Test log events stamped with raw ticks are converted to wall-clock time by worker thread
+ */
+TEST(HelloAWLogger, ClockSource)
+{
+    using namespace std::chrono;
+
+    /* appender which records timestamps and their source when appended */
+    class StampAppender final: public aw_logger::BaseAppender {
+    public:
+        void append(const aw_logger::LogEvent::Ptr& event) override
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            sources_.push_back(event->getStampSource());
+            stamps_.push_back(event->getSysTimestamp());
+        }
+
+        void flush() override {}
+
+        std::mutex mtx_;
+        std::vector<aw_logger::TickClock::source> sources_;
+        std::vector<sys_time<system_clock::duration>> stamps_;
+    };
+
+    for (auto src: { aw_logger::TickClock::source::STEADY, aw_logger::TickClock::source::TSC })
+    {
+        auto logger = aw_logger::getLogger(
+            src == aw_logger::TickClock::source::STEADY ? "clock_steady" : "clock_tsc"
+        );
+        auto appender = std::make_shared<StampAppender>();
+        logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+        logger->setClockSource(src);
+        logger->setAppender(appender);
+        EXPECT_EQ(logger->getClockSource(), src);
+
+        const auto begin = system_clock::now();
+        for (int i = 0; i < 100; i++)
+        {
+            AW_LOG_FMT_INFO(logger, "tick {}", i);
+        }
+        logger->flush();
+        const auto end = system_clock::now();
+
+        std::lock_guard<std::mutex> lk(appender->mtx_);
+        ASSERT_EQ(appender->stamps_.size(), 100);
+        for (size_t i = 0; i < appender->stamps_.size(); i++)
+        {
+            EXPECT_EQ(appender->sources_[i], aw_logger::TickClock::source::SYSTEM);
+            EXPECT_GT(appender->stamps_[i], begin - milliseconds(10));
+            EXPECT_LT(appender->stamps_[i], end + milliseconds(10));
+        }
+    }
+
+    // unresolved ticks fall back to default converter
+    auto logger = aw_logger::getLogger("clock_fallback");
+    aw_logger::LogEvent event;
+    event.reset(
+        logger,
+        aw_logger::LogLevel::level::INFO,
+        std::source_location::current(),
+        aw_logger::TickClock::source::STEADY
+    );
+    EXPECT_EQ(event.getStampSource(), aw_logger::TickClock::source::STEADY);
+    EXPECT_LT(abs(event.getSysTimestamp() - system_clock::now()), milliseconds(10));
+}
+
+/***
+ * @brief Test log events refer to static call site, and source location is rendered once per call site
+ */
+TEST(HelloAWLogger, CallSite)
+{
+    class SiteAppender final: public aw_logger::BaseAppender {
+    public:
+        void append(const aw_logger::LogEvent::Ptr& event) override
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            sites_.push_back(&event->getCallSite());
+            lines_.push_back(formatMsg(event));
+        }
+
+        void flush() override {}
+
+        std::mutex mtx_;
+        std::vector<const aw_logger::CallSite*> sites_;
+        std::vector<std::string> lines_;
+    };
+
+    auto logger = aw_logger::getLogger("call_site");
+    auto appender = std::make_shared<SiteAppender>();
+    appender->setFormatter(std::make_unique<aw_logger::Formatter>(
+        std::make_unique<aw_logger::ComponentFactory>("%l %m")
+    ));
+    logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+    logger->setAppender(appender);
+
+    const auto line = std::source_location::current().line();
+    for (int i = 0; i < 3; i++)
+    {
+        AW_LOG_FMT_WARN(logger, "site {}", i);
+        AW_LOG_ERROR(logger, "another site");
+        logger->log(aw_logger::LogLevel::level::INFO, std::source_location::current(), "runtime site");
+    }
+    logger->flush();
+
+    std::lock_guard<std::mutex> lk(appender->mtx_);
+    ASSERT_EQ(appender->sites_.size(), 9);
+
+    // the same call site for each log call in source code, including interned runtime one
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(appender->sites_[i * 3], appender->sites_[0]);
+        EXPECT_EQ(appender->sites_[i * 3 + 1], appender->sites_[1]);
+        EXPECT_EQ(appender->sites_[i * 3 + 2], appender->sites_[2]);
+    }
+    EXPECT_NE(appender->sites_[0], appender->sites_[1]);
+    EXPECT_NE(appender->sites_[1], appender->sites_[2]);
+
+    // metadata of call site
+    const auto& fmt_site = *appender->sites_[0];
+    EXPECT_EQ(fmt_site.getLogLevel(), aw_logger::LogLevel::level::WARN);
+    EXPECT_EQ(fmt_site.getSourceLocation().line(), line + 3);
+    EXPECT_EQ(fmt_site.getFormat(), "site {}");
+    EXPECT_EQ(appender->sites_[1]->getLogLevel(), aw_logger::LogLevel::level::ERROR);
+    EXPECT_TRUE(appender->sites_[1]->getFormat().empty());
+    EXPECT_EQ(appender->sites_[2]->getLogLevel(), aw_logger::LogLevel::level::INFO);
+    const auto& runtime_loc = appender->sites_[2]->getSourceLocation();
+    EXPECT_EQ(
+        &aw_logger::CallSite::intern(aw_logger::LogLevel::level::INFO, runtime_loc),
+        appender->sites_[2]
+    );
+
+    // cached source location is the same as rendered one
+    EXPECT_EQ(appender->lines_[0], std::format("{} site 0", line + 3));
+    EXPECT_EQ(appender->lines_[3], std::format("{} site 1", line + 3));
+    EXPECT_EQ(appender->lines_[4], std::format("{} another site", line + 4));
+    EXPECT_EQ(appender->lines_[8], std::format("{} runtime site", line + 5));
+
+    // interned call site is the same one for another thread
+    const aw_logger::CallSite* other_site = nullptr;
+    std::thread([&other_site, &runtime_loc]() {
+        other_site = &aw_logger::CallSite::intern(aw_logger::LogLevel::level::INFO, runtime_loc);
+    }).join();
+    EXPECT_EQ(other_site, appender->sites_[2]);
+}
+
+/***
+ * @brief Test log macros with runtime log level
+ */
+TEST(HelloAWLogger, RuntimeLevelMacro)
+{
+    class LevelAppender final: public aw_logger::BaseAppender {
+    public:
+        void append(const aw_logger::LogEvent::Ptr& event) override
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            sites_.push_back(&event->getCallSite());
+        }
+
+        void flush() override {}
+
+        std::mutex mtx_;
+        std::vector<const aw_logger::CallSite*> sites_;
+    };
+
+    using level_t = aw_logger::LogLevel::level;
+    auto logger = aw_logger::getLogger("runtime_level_macro");
+    auto appender = std::make_shared<LevelAppender>();
+    logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+    logger->setAppender(appender);
+
+    const level_t levels[] = { level_t::INFO, level_t::ERROR, level_t::INFO };
+    for (const auto level: levels)
+    {
+        AW_LOG_BASE(logger, level, "runtime level");
+        AW_LOG_FMT_BASE(logger, level, "runtime level {}", 1);
+    }
+    logger->flush();
+
+    // each log level of a call site has its own static call site
+    std::lock_guard<std::mutex> lk(appender->mtx_);
+    ASSERT_EQ(appender->sites_.size(), 6);
+    EXPECT_EQ(appender->sites_[0]->getLogLevel(), level_t::INFO);
+    EXPECT_EQ(appender->sites_[2]->getLogLevel(), level_t::ERROR);
+    EXPECT_EQ(appender->sites_[3]->getLogLevel(), level_t::ERROR);
+    EXPECT_EQ(appender->sites_[3]->getFormat(), "runtime level {}");
+    EXPECT_EQ(appender->sites_[0], appender->sites_[4]);
+    EXPECT_EQ(appender->sites_[1], appender->sites_[5]);
+    EXPECT_NE(appender->sites_[0], appender->sites_[2]);
+    EXPECT_EQ(
+        appender->sites_[0]->getSourceLocation().line(),
+        appender->sites_[2]->getSourceLocation().line()
+    );
+}
+
+/***
+ * @brief Test formatter is shared by concurrent threads without lock, and replaced as a whole
+ */
+TEST(HelloAWLogger, FormatterSnapshot)
+{
+    class SnapshotAppender final: public aw_logger::BaseAppender {
+    public:
+        void append(const aw_logger::LogEvent::Ptr& event) override
+        {
+            /* format outside lock, ONLY collecting results is synchronized */
+            auto line = formatMsg(event);
+            std::lock_guard<std::mutex> lk(mtx_);
+            lines_.push_back(std::move(line));
+        }
+
+        void flush() override {}
+
+        std::mutex mtx_;
+        std::vector<std::string> lines_;
+    };
+
+    const int THREADS = 4;
+    const int ITERATIONS = 500;
+
+    auto logger = aw_logger::getLogger("formatter_snapshot");
+    auto event = std::make_shared<aw_logger::LogEvent>(
+        logger,
+        aw_logger::LogLevel::level::INFO,
+        std::string("snapshot")
+    );
+    const auto make_formatter = [](std::string_view pattern) {
+        return std::make_unique<aw_logger::Formatter>(std::make_unique<aw_logger::ComponentFactory>(pattern));
+    };
+    const auto first = make_formatter("A %l:%p %m")->formatEvent(event);
+    const auto second = make_formatter("B [%f] %m")->formatEvent(event);
+
+    auto appender = std::make_shared<SnapshotAppender>();
+    appender->setFormatter(make_formatter("A %l:%p %m"));
+    const auto snapshot = appender->getFormatter();
+
+    // formatter is replaced while appending concurrently
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++)
+    {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < ITERATIONS; i++)
+                appender->append(event);
+        });
+    }
+    for (int i = 0; i < ITERATIONS; i++)
+        appender->setFormatter(make_formatter(i % 2 == 0 ? "B [%f] %m" : "A %l:%p %m"));
+    for (auto& thread: threads)
+        thread.join();
+
+    ASSERT_EQ(appender->lines_.size(), THREADS * ITERATIONS);
+    for (const auto& line: appender->lines_)
+        EXPECT_TRUE(line == first || line == second) << line;
+
+    // snapshot keeps valid after it's replaced
+    EXPECT_NE(snapshot, appender->getFormatter());
+    EXPECT_EQ(snapshot->formatEvent(event), first);
+}
+
+/***
+ * @brief Test worker thread follows snapshot of appenders once appenders are changed
+ */
+TEST(HelloAWLogger, AppenderSnapshot)
+{
+    class CountAppender final: public aw_logger::BaseAppender {
+    public:
+        void append(const aw_logger::LogEvent::Ptr&) override
+        {
+            count_.fetch_add(1);
+        }
+
+        void flush() override {}
+
+        std::atomic<size_t> count_ { 0 };
+    };
+
+    const int ITERATIONS = 10;
+    auto logger = aw_logger::getLogger("appender_snapshot");
+    logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+    const auto log_burst = [&logger]() {
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            AW_LOG_INFO(logger, "appender snapshot");
+        }
+        logger->flush();
+    };
+
+    auto first = std::make_shared<CountAppender>();
+    auto second = std::make_shared<CountAppender>();
+    logger->setAppender(first);
+    log_burst();
+    EXPECT_EQ(first->count_.load(), ITERATIONS);
+
+    logger->setAppender(second);
+    log_burst();
+    EXPECT_EQ(first->count_.load(), 2 * ITERATIONS);
+    EXPECT_EQ(second->count_.load(), ITERATIONS);
+
+    logger->removeAppender(first);
+    log_burst();
+    EXPECT_EQ(first->count_.load(), 2 * ITERATIONS);
+    EXPECT_EQ(second->count_.load(), 2 * ITERATIONS);
+    EXPECT_THROW(logger->removeAppender(first), aw_logger::invalid_parameter);
+
+    // removed appender is released once worker thread has appended with the new snapshot
+    std::weak_ptr<CountAppender> weak_first = first;
+    first.reset();
+    logger->flush();
+    EXPECT_TRUE(weak_first.expired());
+
+    logger->clearAppenders();
+    logger->setAppender(second);
+    log_burst();
+    EXPECT_EQ(second->count_.load(), 3 * ITERATIONS);
+}
+
+/***
+ * @brief Test appender pipeline keeps a slow appender from stalling the others
+ */
+TEST(HelloAWLogger, AppenderPipeline)
+{
+    class LineAppender final: public aw_logger::BaseAppender {
+    public:
+        explicit LineAppender(std::chrono::milliseconds delay): delay_(delay) {}
+
+        void append(const aw_logger::LogEvent::Ptr& event) override
+        {
+            writeFormatted(formatMsg(event) + "\n");
+        }
+
+        void flush() override {}
+
+        bool isFormattedWritable() const noexcept override
+        {
+            return true;
+        }
+
+        size_t formatBatch(std::string& out, std::span<const aw_logger::LogEvent::Ptr> events)
+            const override
+        {
+            return formatLinesTo(out, events);
+        }
+
+        void writeFormatted(std::string_view bytes) override
+        {
+            std::this_thread::sleep_for(delay_);
+            std::lock_guard<std::mutex> lk(mtx_);
+            lines_ += std::count(bytes.begin(), bytes.end(), '\n');
+            tid_ = std::this_thread::get_id();
+        }
+
+        size_t getLines()
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            return lines_;
+        }
+
+        std::chrono::milliseconds delay_;
+        std::mutex mtx_;
+        size_t lines_ = 0;
+        std::thread::id tid_;
+    };
+
+    class CountAppender final: public aw_logger::BaseAppender {
+    public:
+        void append(const aw_logger::LogEvent::Ptr&) override
+        {
+            count_.fetch_add(1);
+        }
+
+        void flush() override {}
+
+        std::atomic<size_t> count_ { 0 };
+    };
+
+    const size_t ITERATIONS = 200;
+    auto logger = aw_logger::getLogger("appender_pipeline", 1024);
+    logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+    logger->setAppenderPipeline(true, 2, 1024);
+    EXPECT_TRUE(logger->isAppenderPipeline());
+
+    auto slow = std::make_shared<LineAppender>(std::chrono::milliseconds(50));
+    auto fast = std::make_shared<LineAppender>(std::chrono::milliseconds(0));
+    auto fallback = std::make_shared<CountAppender>();
+    logger->setAppenders(slow, fast, fallback);
+
+    for (size_t i = 0; i < ITERATIONS; i++)
+    {
+        AW_LOG_FMT_INFO(logger, "pipeline {}", i);
+    }
+
+    // fast appender catches up while the slow one is still writing its first buffers
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (fast->getLines() < ITERATIONS && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(fast->getLines(), ITERATIONS);
+    EXPECT_LT(slow->getLines(), ITERATIONS);
+
+    // flush waits for I/O thread of each appender
+    logger->flush();
+    EXPECT_EQ(slow->getLines(), ITERATIONS);
+    EXPECT_EQ(fallback->count_.load(), ITERATIONS);
+    EXPECT_NE(slow->tid_, fast->tid_);
+
+    // full queue drops the newest buffers instead of blocking the others
+    logger->setAppenderPipeline(true, 0, 1);
+    logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::DROP_NEWEST);
+    for (size_t i = 0; i < ITERATIONS; i++)
+    {
+        AW_LOG_INFO(logger, "pipeline drop");
+        if (i % 10 == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    logger->flush();
+    EXPECT_LT(slow->getLines(), 2 * ITERATIONS);
+    // dropped log events are counted per appender, and ringbuffer drops nothing
+    EXPECT_GT(logger->getDroppedCount(slow), 0u);
+    EXPECT_EQ(slow->getLines() + logger->getDroppedCount(slow), 2 * ITERATIONS);
+    EXPECT_EQ(fast->getLines() + logger->getDroppedCount(fast), 2 * ITERATIONS);
+    EXPECT_EQ(logger->getDroppedCount(fallback), 0u);
+    EXPECT_EQ(logger->getDroppedCount(), 0u);
+
+    logger->setAppenderPipeline(false);
+    EXPECT_FALSE(logger->isAppenderPipeline());
+    logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+    const auto fast_lines = fast->getLines();
+    AW_LOG_INFO(logger, "pipeline disabled");
+    logger->flush();
+    EXPECT_EQ(fast->getLines(), fast_lines + 1);
+    logger->clearAppenders();
+}
+
+/***
+ * @brief Test file appender outputs the same bytes and rotates the same way through each I/O backend
+ */
+TEST(HelloAWLogger, FileBackend)
+{
+    using backend_t = aw_logger::FileAppender::ioBackend;
+
+    const auto log_dir = std::filesystem::current_path() / "test";
+    std::filesystem::create_directories(log_dir);
+    const auto read_file = [](const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    const auto make_appender = [](const std::filesystem::path& path, size_t capacity, backend_t backend) {
+        return std::make_shared<aw_logger::FileAppender>(
+            std::make_unique<aw_logger::Formatter>(std::make_unique<aw_logger::ComponentFactory>("%m")),
+            path.string(),
+            true,
+            capacity,
+            backend
+        );
+    };
+
+    for (const auto backend: { backend_t::STREAM, backend_t::POSIX, backend_t::MMAP, backend_t::URING })
+    {
+        const auto suffix = backend == backend_t::URING ? "uring"
+            : backend == backend_t::MMAP                ? "mmap"
+            : backend == backend_t::POSIX               ? "posix"
+                                                        : "stream";
+        const auto log_path = log_dir / (std::string("file_backend_") + suffix + ".log");
+
+        // small buffers are staged, then gathered with the large one into ONE write,
+        // and mapping rolls to the next segment while the large one crosses it
+        auto appender = make_appender(log_path, 64, backend);
+        // io_uring falls back to plain write path if kernel does NOT support it
+        if (backend == backend_t::URING && !aw_logger::IoUring::isAvailable())
+            EXPECT_EQ(appender->getBackend(), backend_t::POSIX);
+        else
+            EXPECT_EQ(appender->getBackend(), backend);
+        appender->setSegmentSize(4096);
+        appender->setDurable(backend == backend_t::URING);
+        const std::string large(5000, 'x');
+        const std::string_view buffers[] = { "a\n", "bb\n", large };
+        appender->writeFormattedBatch(buffers);
+        appender->writeFormatted("tail\n");
+        appender->flush();
+        EXPECT_EQ(appender->getFileSize(), 10u + large.size());
+        // mapped file is preallocated beyond its real size until it's closed
+        EXPECT_EQ(read_file(log_path).substr(0, appender->getFileSize()), "a\nbb\n" + large + "tail\n");
+        if (backend == backend_t::MMAP)
+        {
+            EXPECT_EQ(std::filesystem::file_size(log_path), 8192u);
+        }
+
+        // more buffers than ONE batch of io_uring are gathered while memory buffer is empty
+        std::vector<std::string> gathered(70);
+        std::vector<std::string_view> gathered_views;
+        std::string gathered_content;
+        for (size_t i = 0; i < gathered.size(); i++)
+        {
+            gathered[i] = std::string(9, static_cast<char>('a' + i % 26)) + '\n';
+            gathered_views.emplace_back(gathered[i]);
+            gathered_content += gathered[i];
+        }
+        const size_t gathered_begin = appender->getFileSize();
+        appender->writeFormattedBatch(gathered_views);
+        appender->flush();
+        EXPECT_EQ(appender->getFileSize(), gathered_begin + gathered_content.size());
+        EXPECT_EQ(read_file(log_path).substr(gathered_begin, gathered_content.size()), gathered_content);
+
+        // rotation keeps its semantics
+        appender->setMaxFileSize(128);
+        appender->setMaxBackupNum(2);
+        const std::string line(60, 'y');
+        appender->writeFormatted(line);
+        appender->flush();
+        const auto backup_path = log_dir / (std::string("file_backend_") + suffix + "_backup1.log");
+        EXPECT_TRUE(std::filesystem::exists(backup_path));
+        EXPECT_EQ(read_file(backup_path).size(), 10u + large.size() + gathered_content.size() + line.size());
+        EXPECT_EQ(appender->getFileSize(), 0u);
+
+        // log events go through the backend on worker thread and appender pipeline alike,
+        // first written synchronously, then sealed buffers of asynchronous flush are written together
+        appender->setMaxFileSize(0);
+        auto logger = aw_logger::getLogger(std::string("file_backend_") + suffix);
+        logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+        logger->setAppender(appender);
+        std::string content;
+        for (const bool async_flush: { false, true })
+        {
+            appender->setAsyncFlush(async_flush, 3);
+            for (const bool pipeline: { false, true })
+            {
+                logger->setAppenderPipeline(pipeline);
+                for (int i = 0; i < 100; i++)
+                {
+                    AW_LOG_FMT_INFO(logger, "line {}", i);
+                }
+                logger->flush();
+            }
+            content = read_file(log_path).substr(0, appender->getFileSize());
+            EXPECT_EQ(std::count(content.begin(), content.end(), '\n'), async_flush ? 400 : 200);
+        }
+        logger->setAppenderPipeline(false);
+        logger->clearAppenders();
+
+        // file is truncated to its real size on close
+        appender->reopen();
+        EXPECT_EQ(read_file(log_path), content);
+
+        std::filesystem::remove(log_path);
+        std::filesystem::remove(backup_path);
+    }
+}
+
+/***
+ * @brief Test mapped file appends right after the last byte written if zero-filled tail is left by a crash
+ */
+TEST(HelloAWLogger, MmapZeroTail)
+{
+    const auto log_path = std::filesystem::current_path() / "test" / "mmap_zero_tail.log";
+    std::filesystem::create_directories(log_path.parent_path());
+    {
+        // crashed process leaves preallocated segment untruncated
+        std::ofstream file(log_path, std::ios::binary | std::ios::trunc);
+        file << "before crash\n" << std::string(10000, '\0');
+    }
+
+    auto appender = std::make_shared<aw_logger::FileAppender>(
+        std::make_unique<aw_logger::Formatter>(std::make_unique<aw_logger::ComponentFactory>("%m")),
+        log_path.string(),
+        false,
+        64,
+        aw_logger::FileAppender::ioBackend::MMAP
+    );
+    EXPECT_EQ(appender->getFileSize(), 13u);
+    appender->writeFormatted("after crash\n");
+    appender->flush();
+    appender.reset();
+
+    std::ifstream file(log_path, std::ios::binary);
+    const std::string content(std::istreambuf_iterator<char>(file), {});
+    EXPECT_EQ(content, "before crash\nafter crash\n");
+    std::filesystem::remove(log_path);
+}
+
+/***
+ * @brief Test asynchronous flush keeps appending thread away from a slow disk
+ */
+TEST(HelloAWLogger, AsyncFlush)
+{
+    // slow disk: a FIFO whose reader does NOT read until appending returns, so that writes block once
+    // the pipe is full
+    const auto fifo_path = std::filesystem::current_path() / "test" / "async_flush.fifo";
+    std::filesystem::create_directories(fifo_path.parent_path());
+    std::filesystem::remove(fifo_path);
+    ASSERT_EQ(::mkfifo(fifo_path.c_str(), 0644), 0);
+
+    // reader gives up waiting after it, so that blocked appending in synchronous mode ends
+    const auto MAX_STALL = std::chrono::seconds(1);
+    // more than the pipe, and ONE less than buffers of asynchronous flush
+    const size_t CHUNK_NUM = 3;
+
+    const auto run = [&](bool async) {
+        // the pipe is shrunk to ONE chunk by a holder opened before the others
+        const int holder = ::open(fifo_path.c_str(), O_RDWR);
+        EXPECT_GE(holder, 0);
+        size_t chunk_size = 64 * 1024;
+#ifdef F_SETPIPE_SZ
+        static_cast<void>(::fcntl(holder, F_SETPIPE_SZ, 4096));
+        chunk_size = static_cast<size_t>(::fcntl(holder, F_GETPIPE_SZ));
+#endif
+        std::string expected;
+        for (size_t i = 0; i < CHUNK_NUM; i++)
+        {
+            expected.append(chunk_size, static_cast<char>('a' + i));
+        }
+
+        std::atomic<bool> is_returned { false };
+        std::atomic<bool> is_reading { false };
+        std::string received;
+        const int fd = ::open(fifo_path.c_str(), O_RDONLY);
+        std::thread reader([&]() {
+            const auto deadline = std::chrono::steady_clock::now() + MAX_STALL;
+            while (!is_returned.load() && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            is_reading.store(true);
+            char chunk[4096];
+            ssize_t size = 0;
+            while ((size = ::read(fd, chunk, sizeof(chunk))) > 0)
+            {
+                received.append(chunk, static_cast<size_t>(size));
+            }
+            ::close(fd);
+        });
+
+        auto appender = std::make_shared<aw_logger::FileAppender>(
+            std::make_unique<aw_logger::Formatter>(std::make_unique<aw_logger::ComponentFactory>("%m")),
+            fifo_path.string(),
+            true,
+            chunk_size,
+            aw_logger::FileAppender::ioBackend::POSIX
+        );
+        ::close(holder);
+        appender->setAsyncFlush(async, CHUNK_NUM + 1);
+        EXPECT_EQ(appender->isAsyncFlush(), async);
+
+        for (size_t i = 0; i < CHUNK_NUM; i++)
+        {
+            appender->writeFormatted(std::string_view(expected).substr(i * chunk_size, chunk_size));
+        }
+        // whether appending had to wait for the reader
+        const bool is_waited = is_reading.load();
+        is_returned.store(true);
+
+        // flush still waits for disk, and closing the FIFO ends the reader
+        appender->flush();
+        appender.reset();
+        reader.join();
+        EXPECT_EQ(received, expected);
+        return is_waited;
+    };
+
+    EXPECT_TRUE(run(false));
+    EXPECT_FALSE(run(true));
+
+    EXPECT_THROW(
+        aw_logger::FileAppender((std::filesystem::current_path() / "test" / "async_flush.log").string())
+            .setAsyncFlush(true, 1),
+        aw_logger::invalid_parameter
+    );
+    std::filesystem::remove(fifo_path);
+    std::filesystem::remove(std::filesystem::current_path() / "test" / "async_flush.log");
+}
+
+/***
+ * @brief Test rotation switches to the pre-opened next file, and backup files are shuffled in order
+ */
+TEST(HelloAWLogger, AsyncRotation)
+{
+    using backend_t = aw_logger::FileAppender::ioBackend;
+
+    const auto log_dir = std::filesystem::current_path() / "test";
+    std::filesystem::create_directories(log_dir);
+    const auto read_file = [](const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    const auto make_line = [](int index) {
+        auto line = "line " + std::to_string(index);
+        line.resize(59, '.');
+        return line + '\n';
+    };
+
+    for (const auto backend: { backend_t::STREAM, backend_t::POSIX, backend_t::MMAP })
+    {
+        const auto suffix = backend == backend_t::MMAP ? "mmap" : backend == backend_t::POSIX ? "posix" : "stream";
+        const auto stem = std::string("async_rotation_") + suffix;
+        const auto log_path = log_dir / (stem + ".log");
+        const auto backup_path = [&](int index) {
+            return log_dir / (stem + "_backup" + std::to_string(index) + ".log");
+        };
+        const auto next_path = log_dir / (stem + "_next.log");
+
+        // write through, so that every second line rotates the file
+        auto appender = std::make_shared<aw_logger::FileAppender>(
+            std::make_unique<aw_logger::Formatter>(std::make_unique<aw_logger::ComponentFactory>("%m")),
+            log_path.string(),
+            true,
+            0,
+            backend
+        );
+        appender->setMaxFileSize(100);
+        appender->setMaxBackupNum(3);
+        for (int i = 0; i < 10; i++)
+        {
+            appender->writeFormatted(make_line(i));
+        }
+        EXPECT_EQ(appender->getFileSize(), 0u);
+
+        // flush waits for rotation thread, and the oldest backups are dropped
+        appender->flush();
+        for (int i = 1; i <= 3; i++)
+        {
+            EXPECT_EQ(read_file(backup_path(i)), make_line(10 - 2 * i) + make_line(11 - 2 * i));
+        }
+        EXPECT_FALSE(std::filesystem::exists(backup_path(4)));
+        for (const auto& entry: std::filesystem::directory_iterator(log_dir))
+        {
+            EXPECT_EQ(entry.path().filename().string().find(stem + "_retired"), std::string::npos);
+        }
+
+        // the next file is pre-opened for the coming rotation, and it takes place of log file
+        EXPECT_TRUE(std::filesystem::exists(next_path));
+        appender->writeFormatted(make_line(10));
+        appender->writeFormatted(make_line(11));
+        appender->writeFormatted(make_line(12));
+        appender->flush();
+        EXPECT_EQ(read_file(backup_path(1)), make_line(10) + make_line(11));
+        EXPECT_EQ(read_file(log_path).substr(0, appender->getFileSize()), make_line(12));
+
+        // the next file is removed once appender is destroyed
+        appender.reset();
+        EXPECT_FALSE(std::filesystem::exists(next_path));
+        EXPECT_EQ(read_file(log_path), make_line(12));
+
+        std::filesystem::remove(log_path);
+        for (int i = 1; i <= 3; i++)
+        {
+            std::filesystem::remove(backup_path(i));
+        }
+    }
+}
+
+/***
+ * @brief Test retired and next files left by an interrupted rotation are settled once appender is constructed
+ */
+TEST(HelloAWLogger, RotationLeftovers)
+{
+    const auto log_dir = std::filesystem::current_path() / "test";
+    std::filesystem::create_directories(log_dir);
+    const auto read_file = [](const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    const auto write_file = [](const std::filesystem::path& path, std::string_view content) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    };
+    const auto log_path = log_dir / "rotation_leftovers.log";
+    const auto backup_path = [&](int index) {
+        return log_dir / ("rotation_leftovers_backup" + std::to_string(index) + ".log");
+    };
+
+    // process exited before rotation thread shuffled its retired files
+    write_file(backup_path(1), "backup\n");
+    write_file(log_dir / "rotation_leftovers_retired2.log", "retired2\n");
+    write_file(log_dir / "rotation_leftovers_retired10.log", "retired10\n");
+    write_file(log_dir / "rotation_leftovers_next.log", "");
+    write_file(log_dir / "rotation_leftovers_retiredx.log", "unrelated\n");
+    write_file(log_path, "current\n");
+
+    {
+        auto appender = std::make_shared<aw_logger::FileAppender>(log_path.string(), false);
+        EXPECT_EQ(appender->getFileSize(), 8u);
+    }
+
+    // retired files join backup files in order of their sequence numbers
+    EXPECT_EQ(read_file(backup_path(1)), "retired10\n");
+    EXPECT_EQ(read_file(backup_path(2)), "retired2\n");
+    EXPECT_EQ(read_file(backup_path(3)), "backup\n");
+    EXPECT_FALSE(std::filesystem::exists(log_dir / "rotation_leftovers_retired2.log"));
+    EXPECT_FALSE(std::filesystem::exists(log_dir / "rotation_leftovers_retired10.log"));
+    EXPECT_FALSE(std::filesystem::exists(log_dir / "rotation_leftovers_next.log"));
+    EXPECT_EQ(read_file(log_dir / "rotation_leftovers_retiredx.log"), "unrelated\n");
+    EXPECT_EQ(read_file(log_path), "current\n");
+
+    std::filesystem::remove(log_path);
+    std::filesystem::remove(log_dir / "rotation_leftovers_retiredx.log");
+    for (int i = 1; i <= 3; i++)
+    {
+        std::filesystem::remove(backup_path(i));
+    }
+}
+
+/***
+ * @brief Test color escape codes are resolved per log level once the factory is built
+ */
+TEST(HelloAWLogger, LevelColors)
+{
+    const auto index = [](aw_logger::LogLevel::level level) { return static_cast<size_t>(level); };
+
+    // colors from settings
+    aw_logger::ComponentFactory settings_factory;
+    EXPECT_EQ(
+        settings_factory.level_colors_[index(aw_logger::LogLevel::level::INFO)],
+        aw_logger::ComponentFactory::formatColor("cyan")
+    );
+    EXPECT_EQ(
+        settings_factory.level_colors_[index(aw_logger::LogLevel::level::FATAL)],
+        aw_logger::ComponentFactory::formatColor("magenta")
+    );
+    EXPECT_TRUE(settings_factory.level_colors_[index(aw_logger::LogLevel::level::UNKNOWN)].empty());
+    EXPECT_EQ(aw_logger::ComponentFactory::formatColor("red"), "\033[38;2;255;0;0m");
+
+    // colored level and message of formatted log event
+    auto logger = aw_logger::getLogger("level_colors");
+    aw_logger::Formatter formatter(std::make_unique<aw_logger::ComponentFactory>());
+    auto event = std::make_shared<aw_logger::LogEvent>(
+        logger,
+        aw_logger::LogLevel::level::ERROR,
+        std::string("colored")
+    );
+    const auto red = aw_logger::ComponentFactory::formatColor("red");
+    const auto result = formatter.formatEvent(event);
+    EXPECT_NE(result.find(red + "[ERROR]" + aw_logger::Color::endColor), std::string::npos);
+    EXPECT_NE(result.find(red + "colored" + aw_logger::Color::endColor), std::string::npos);
+
+    // pattern has no color
+    aw_logger::ComponentFactory pattern_factory("%p %m");
+    for (const auto& color: pattern_factory.level_colors_)
+    {
+        EXPECT_TRUE(color.empty());
+    }
+}
+
 TEST(HelloAWLogger, WebsocketLogging)
 {
     auto websocket_appender = std::make_shared<aw_logger::WebsocketAppender>("ws://127.0.0.1:1234");
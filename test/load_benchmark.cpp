@@ -21,7 +21,12 @@
 // C++ standard library
 #include <fcntl.h>
 #include <unistd.h>
+#include <condition_variable>
+#include <fstream>
 #include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -455,4 +460,665 @@ TEST(BenchmarkLogger, MultiThreadedLogging)
     SUCCEED();
 }
 
+/***
+ * @brief drain ringbuffer with one consumer while multiple producers push into it
+ * @tparam RingBufferT ringbuffer type
+ * @param num_producers number of producer threads
+ * @param items_per_producer number of items pushed by each producer
+ * @return elapsed time in nanoseconds
+ */
+template<typename RingBufferT>
+long long drainRingBuffer(int num_producers, int items_per_producer)
+{
+    RingBufferT rb(1024);
+    const size_t total_items = static_cast<size_t>(num_producers) * items_per_producer;
+    std::vector<std::thread> producers;
+
+    aw_test::TicToc timer;
+    timer.tic();
+
+    for (int p = 0; p < num_producers; p++)
+    {
+        producers.emplace_back([&rb, items_per_producer]() {
+            for (int i = 0; i < items_per_producer; i++)
+            {
+                while (!rb.push(static_cast<size_t>(i)))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    /* single consumer */
+    std::vector<size_t> batch;
+    batch.reserve(128);
+    size_t popped = 0;
+    while (popped < total_items)
+    {
+        batch.clear();
+        const size_t n = rb.pop_bulk(std::back_inserter(batch), 128);
+        if (n == 0)
+            std::this_thread::yield();
+        popped += n;
+    }
+
+    const long long elapsed = timer.toc();
+    for (auto& producer: producers)
+    {
+        producer.join();
+    }
+    return elapsed;
+}
+
+/***
+ * @brief Benchmark: MPMC vs MPSC ringbuffer policy with single consumer
+ */
+TEST(BenchmarkLogger, RingBufferPolicy_Comparison)
+{
+    const int NUM_PRODUCERS = 16;
+    const int ITEMS_PER_PRODUCER = 100000;
+    const int ROUNDS = 5;
+    const double total_items = static_cast<double>(NUM_PRODUCERS) * ITEMS_PER_PRODUCER;
+
+    std::cerr << "\n[Test 11] RingBuffer MPMC vs MPSC (" << NUM_PRODUCERS << " producers, 1 consumer, "
+              << ITEMS_PER_PRODUCER << " items per producer, " << ROUNDS << " rounds)\n";
+
+    long long mpmc_elapsed = 0, mpsc_elapsed = 0;
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        mpmc_elapsed += drainRingBuffer<aw_logger::RingBuffer<size_t>>(
+            NUM_PRODUCERS,
+            ITEMS_PER_PRODUCER
+        );
+        mpsc_elapsed += drainRingBuffer<aw_logger::MPSCRingBuffer<size_t>>(
+            NUM_PRODUCERS,
+            ITEMS_PER_PRODUCER
+        );
+    }
+
+    std::cerr << std::fixed << std::setprecision(3);
+    std::cerr << "MPMC: " << mpmc_elapsed / ROUNDS / 1e6 << " ms/round, "
+              << static_cast<long long>(total_items * ROUNDS / (mpmc_elapsed / 1e9)) << " items/sec\n";
+    std::cerr << "MPSC: " << mpsc_elapsed / ROUNDS / 1e6 << " ms/round, "
+              << static_cast<long long>(total_items * ROUNDS / (mpsc_elapsed / 1e9)) << " items/sec\n";
+    SUCCEED();
+}
+
+/***
+ * @brief appender which discards log events, to measure pure logger cost
+ */
+class NullAppender final: public aw_logger::BaseAppender {
+public:
+    void append(const aw_logger::LogEvent::Ptr&) override {}
+
+    void flush() override {}
+};
+
+/***
+ * @brief Benchmark: submit latency with adaptive notification vs lock + notify on every submit
+ */
+TEST(BenchmarkLogger, SubmitNotify_Comparison)
+{
+    const int BURSTS = 200;
+    const int BURST_SIZE = 100;
+
+    std::cerr << "\n[Test 12] Submit Latency, adaptive notify vs lock + notify (" << BURSTS
+              << " bursts of " << BURST_SIZE << " calls)\n";
+
+    auto logger = aw_logger::getLogger("submit_notify", BURSTS * BURST_SIZE);
+    ASSERT_NE(logger, nullptr);
+    logger->setAppender(std::make_shared<NullAppender>());
+
+    /* build log events in advance, so that ONLY `submit()` is measured */
+    const auto make_events = [&logger]() {
+        std::vector<aw_logger::LogEvent::Ptr> events;
+        events.reserve(BURSTS * BURST_SIZE);
+        for (int i = 0; i < BURSTS * BURST_SIZE; i++)
+        {
+            events.emplace_back(std::make_shared<aw_logger::LogEvent>(
+                logger,
+                aw_logger::LogLevel::level::INFO,
+                std::string("Benchmark test message")
+            ));
+        }
+        return events;
+    };
+
+    /* emulate the legacy path: take a mutex and notify a parked waiter on every submit */
+    std::mutex legacy_mtx;
+    std::condition_variable legacy_cv;
+    bool legacy_stop = false;
+    std::thread legacy_waiter([&]() {
+        std::unique_lock<std::mutex> lk(legacy_mtx);
+        legacy_cv.wait(lk, [&legacy_stop]() { return legacy_stop; });
+    });
+
+    const auto run = [&](bool legacy) {
+        aw_test::Latency stats;
+        auto events = make_events();
+        for (int b = 0; b < BURSTS; b++)
+        {
+            for (int i = 0; i < BURST_SIZE; i++)
+            {
+                aw_test::TicToc timer;
+                timer.tic();
+                logger->submit(events[b * BURST_SIZE + i]);
+                if (legacy)
+                {
+                    std::lock_guard<std::mutex> lk(legacy_mtx);
+                    legacy_cv.notify_one();
+                }
+                stats.add(timer.toc());
+            }
+            /* idle gap between bursts, worker thread has time to park */
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        logger->flush();
+        return stats;
+    };
+
+    run(true).print("Submit (lock + notify, legacy)", std::cerr);
+    run(false).print("Submit (adaptive notify)", std::cerr);
+    {
+        std::lock_guard<std::mutex> lk(legacy_mtx);
+        legacy_stop = true;
+    }
+    legacy_cv.notify_one();
+    legacy_waiter.join();
+
+    EXPECT_EQ(logger->getDroppedCount(), 0);
+}
+
+/***
+ * @brief Benchmark: pre-parsed format string vs `std::vformat_to()`
+ */
+TEST(BenchmarkLogger, FormatSpec_Comparison)
+{
+    const int ITERATIONS = 100000;
+
+    std::cerr << "\n[Test 13] Pre-parsed format string vs std::vformat_to (" << ITERATIONS
+              << " calls each)\n";
+
+    static constexpr std::string_view FMT = "Multi: int={}, double={:.3f}, str={}, bool={}";
+    static constexpr aw_logger::FormatSpec spec(FMT);
+    ASSERT_TRUE(spec.isParsed());
+
+    std::string out;
+    out.reserve(256);
+    const std::string str = "test";
+
+    {
+        aw_test::Latency stats;
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            const double value = 3.14159 * i;
+            const bool flag = i % 2 == 0;
+            aw_test::TicToc timer;
+            timer.tic();
+            out.clear();
+            std::vformat_to(std::back_inserter(out), FMT, std::make_format_args(i, value, str, flag));
+            stats.add(timer.toc());
+        }
+        stats.print("std::vformat_to (parse every call)", std::cerr);
+    }
+
+    {
+        aw_test::Latency stats;
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            const double value = 3.14159 * i;
+            const bool flag = i % 2 == 0;
+            aw_test::TicToc timer;
+            timer.tic();
+            out.clear();
+            spec.formatTo(out, i, value, str, flag);
+            stats.add(timer.toc());
+        }
+        stats.print("FormatSpec::formatTo (pre-parsed)", std::cerr);
+    }
+
+    /* every field has a spec, which is parsed ONCE into its formatter */
+    static constexpr std::string_view SPEC_FMT = "Spec: int={:>8}, double={:.3f}, hex={:#x}";
+    static constexpr aw_logger::FormatSpec spec_only(SPEC_FMT);
+    ASSERT_TRUE(spec_only.isParsed());
+
+    {
+        aw_test::Latency stats;
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            const double value = 3.14159 * i;
+            aw_test::TicToc timer;
+            timer.tic();
+            out.clear();
+            std::vformat_to(std::back_inserter(out), SPEC_FMT, std::make_format_args(i, value, i));
+            stats.add(timer.toc());
+        }
+        stats.print("std::vformat_to, spec'd fields (parse every call)", std::cerr);
+    }
+
+    {
+        aw_test::Latency stats;
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            const double value = 3.14159 * i;
+            aw_test::TicToc timer;
+            timer.tic();
+            out.clear();
+            spec_only.formatTo(out, i, value, i);
+            stats.add(timer.toc());
+        }
+        stats.print("FormatSpec::formatTo, spec'd fields (parsed formatters)", std::cerr);
+    }
+}
+
+/***
+ * @brief Benchmark: compiled formatter instructions vs string dispatch of components
+ */
+TEST(BenchmarkLogger, FormatterInstructions_Comparison)
+{
+    const int ITERATIONS = 100000;
+
+    std::cerr << "\n[Test 14] Formatter, compiled instructions vs string dispatch (" << ITERATIONS
+              << " calls each)\n";
+
+    auto logger = aw_logger::getLogger("formatter_instructions");
+    aw_logger::Formatter formatter(std::make_unique<aw_logger::ComponentFactory>());
+    auto event = std::make_shared<aw_logger::LogEvent>(
+        logger,
+        aw_logger::LogLevel::level::INFO,
+        std::string("Benchmark test message")
+    );
+    const auto& components = formatter.getRegisteredComponents();
+
+    {
+        aw_test::Latency stats;
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            aw_test::TicToc timer;
+            timer.tic();
+            auto result = formatter.formatComponents(event, components);
+            stats.add(timer.toc());
+        }
+        stats.print("formatComponents (string dispatch)", std::cerr);
+    }
+
+    {
+        aw_test::Latency stats;
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            aw_test::TicToc timer;
+            timer.tic();
+            auto result = formatter.formatEvent(event);
+            stats.add(timer.toc());
+        }
+        stats.print("formatEvent (compiled instructions)", std::cerr);
+    }
+}
+
+/***
+ * @brief Benchmark: cached timestamp prefix vs `std::format` of timestamp per event
+ */
+TEST(BenchmarkLogger, TimestampCache_Comparison)
+{
+    const int ITERATIONS = 100000;
+
+    std::cerr << "\n[Test 15] Timestamp, cached per-second prefix vs std::format (" << ITERATIONS
+              << " calls each)\n";
+
+    auto logger = aw_logger::getLogger("timestamp_cache");
+    aw_logger::Formatter formatter(std::make_unique<aw_logger::ComponentFactory>("%t"));
+    const auto& components = formatter.getRegisteredComponents();
+
+    /* fresh log events, so that timestamps move forward like real logging */
+    std::vector<aw_logger::LogEvent::Ptr> events;
+    events.reserve(ITERATIONS);
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        events.emplace_back(std::make_shared<aw_logger::LogEvent>(
+            logger,
+            aw_logger::LogLevel::level::INFO,
+            std::string("Benchmark test message")
+        ));
+    }
+
+    {
+        aw_test::Latency stats;
+        for (const auto& event: events)
+        {
+            aw_test::TicToc timer;
+            timer.tic();
+            auto result = formatter.formatComponents(event, components);
+            stats.add(timer.toc());
+        }
+        stats.print("std::format timestamp (per event)", std::cerr);
+    }
+
+    {
+        aw_test::Latency stats;
+        for (const auto& event: events)
+        {
+            aw_test::TicToc timer;
+            timer.tic();
+            auto result = formatter.formatEvent(event);
+            stats.add(timer.toc());
+        }
+        stats.print("cached timestamp prefix", std::cerr);
+    }
+}
+
+/***
+ * @brief Benchmark: caller latency with different sources of timestamp ticks
+ */
+TEST(BenchmarkLogger, ClockSource_Comparison)
+{
+    const int BURSTS = 100;
+    const int BURST_SIZE = 100;
+
+    std::cerr << "\n[Test 16] Caller latency, system clock vs steady clock vs cycle counter (" << BURSTS
+              << " bursts of " << BURST_SIZE << " calls)\n";
+
+    auto logger = aw_logger::getLogger("clock_source", BURSTS * BURST_SIZE);
+    ASSERT_NE(logger, nullptr);
+    logger->setAppender(std::make_shared<NullAppender>());
+
+    const auto run = [&](aw_logger::TickClock::source src, const char* label) {
+        logger->setClockSource(src);
+        aw_test::Latency stats;
+        for (int b = 0; b < BURSTS; b++)
+        {
+            for (int i = 0; i < BURST_SIZE; i++)
+            {
+                aw_test::TicToc timer;
+                timer.tic();
+                AW_LOG_INFO(logger, "Benchmark test message");
+                stats.add(timer.toc());
+            }
+            logger->flush();
+        }
+        stats.print(label, std::cerr);
+    };
+
+    /* warm up event pool and converters */
+    run(aw_logger::TickClock::source::TSC, "warm up");
+    run(aw_logger::TickClock::source::SYSTEM, "system clock (wall-clock time on caller thread)");
+    run(aw_logger::TickClock::source::STEADY, "steady clock (converted on worker thread)");
+    run(aw_logger::TickClock::source::TSC, "cycle counter (converted on worker thread)");
+
+    EXPECT_EQ(logger->getDroppedCount(), 0);
+}
+
+/***
+ * @brief Benchmark: precompiled pattern vs JSON components, formatted into reused buffer
+ */
+TEST(BenchmarkLogger, PatternEngine_Comparison)
+{
+    const int ITERATIONS = 100000;
+
+    std::cerr << "\n[Test 17] Formatter, pattern string vs JSON components (" << ITERATIONS
+              << " calls each)\n";
+
+    auto logger = aw_logger::getLogger("pattern_engine");
+    auto event = std::make_shared<aw_logger::LogEvent>(
+        logger,
+        aw_logger::LogLevel::level::INFO,
+        std::string("Benchmark test message")
+    );
+
+    const auto run = [&event](aw_logger::Formatter& formatter, const char* label) {
+        std::string buffer;
+        buffer.reserve(1024);
+        aw_test::Latency stats;
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            aw_test::TicToc timer;
+            timer.tic();
+            buffer.clear();
+            formatter.formatTo(buffer, event);
+            stats.add(timer.toc());
+        }
+        stats.print(label, std::cerr);
+    };
+
+    aw_logger::Formatter json_formatter(std::make_unique<aw_logger::ComponentFactory>());
+    aw_logger::Formatter pattern_formatter(
+        std::make_unique<aw_logger::ComponentFactory>("%t %p [%f:%n:%l] %i %m")
+    );
+    aw_logger::Formatter padded_formatter(
+        std::make_unique<aw_logger::ComponentFactory>("%.6t %-7p %-16c %=12T %8r %.40m")
+    );
+
+    run(json_formatter, "JSON components (settings)");
+    run(pattern_formatter, "pattern string");
+    run(padded_formatter, "pattern string with width and new conversions");
+}
+
+/***
+ * @brief Benchmark: time until file appender gets a burst, with a slow network-like appender attached
+ */
+TEST(BenchmarkLogger, AppenderPipeline_Comparison)
+{
+    const int ROUNDS = 20;
+    const size_t BURST_SIZE = 256;
+
+    std::cerr << "\n[Test 18] File appender next to a slow appender, worker thread vs appender pipeline ("
+              << ROUNDS << " bursts of " << BURST_SIZE << " calls)\n";
+
+    /* it takes 200us to send each pre-formatted buffer or each log event */
+    class SlowAppender final: public aw_logger::BaseAppender {
+    public:
+        void append(const aw_logger::LogEvent::Ptr&) override
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+
+        void flush() override {}
+
+        bool isFormattedWritable() const noexcept override
+        {
+            return true;
+        }
+
+        size_t formatBatch(std::string& out, std::span<const aw_logger::LogEvent::Ptr> events)
+            const override
+        {
+            return formatLinesTo(out, events);
+        }
+
+        void writeFormatted(std::string_view) override
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    };
+
+    const auto run = [&](bool pipeline, const char* label) {
+        const std::string name = pipeline ? "pipeline_on" : "pipeline_off";
+        const std::string file_path = "/tmp/aw_" + name + ".log";
+        auto logger = aw_logger::getLogger(name, 1024);
+        logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+        logger->setAppenderPipeline(pipeline, 1);
+
+        /* write through, so that file size shows what the file appender has got */
+        auto file_appender = std::make_shared<aw_logger::FileAppender>(
+            std::make_unique<aw_logger::Formatter>(std::make_unique<aw_logger::ComponentFactory>("%m")),
+            file_path,
+            true,
+            0
+        );
+        logger->setAppenders(std::make_shared<SlowAppender>(), file_appender);
+
+        const std::string msg = "Benchmark test message";
+        aw_test::Latency stats;
+        for (int r = 0; r < ROUNDS; r++)
+        {
+            const size_t expected_size = file_appender->getFileSize() + BURST_SIZE * (msg.size() + 1);
+            aw_test::TicToc timer;
+            timer.tic();
+            for (size_t i = 0; i < BURST_SIZE; i++)
+            {
+                AW_LOG_INFO(logger, msg);
+            }
+            while (file_appender->getFileSize() < expected_size)
+            {
+                std::this_thread::yield();
+            }
+            stats.add(timer.toc());
+            logger->flush();
+        }
+        stats.print(label, std::cerr);
+
+        logger->clearAppenders();
+        std::remove(file_path.c_str());
+    };
+
+    run(false, "worker thread appends sequentially (ns per burst)");
+    run(true, "appender pipeline (ns per burst)");
+}
+
+/***
+ * @brief get number of write syscalls made by this process so far
+ * @return number of write syscalls, 0 if `/proc/self/io` is not available
+ */
+static long long getWriteSyscallNum()
+{
+    std::ifstream io("/proc/self/io");
+    std::string key;
+    long long value = 0;
+    while (io >> key >> value)
+    {
+        if (key == "syscw:")
+            return value;
+    }
+    return 0;
+}
+
+/***
+ * @brief Benchmark: file appender throughput and write syscalls, std::ofstream vs POSIX writev vs mmap vs io_uring
+ */
+TEST(BenchmarkLogger, FileBackend_Comparison)
+{
+    using backend_t = aw_logger::FileAppender::ioBackend;
+    const int ROUNDS = 10;
+    const int EVENTS = 10000;
+
+    std::cerr << "\n[Test 19] File appender, std::ofstream vs POSIX writev vs mmap vs io_uring (" << ROUNDS << " rounds of "
+              << EVENTS << " calls)\n";
+
+    const auto run = [&](backend_t backend, bool pipeline, const char* label) {
+        const std::string name = std::string("file_backend_")
+            + (backend == backend_t::URING ? "uring"
+                   : backend == backend_t::MMAP  ? "mmap"
+                   : backend == backend_t::POSIX ? "posix"
+                                                 : "stream")
+            + (pipeline ? "_pipeline" : "");
+        const std::string file_path = "/tmp/aw_" + name + ".log";
+        auto logger = aw_logger::getLogger(name, 16384);
+        logger->setOverflowPolicy(aw_logger::Logger::overflowPolicy::BLOCK);
+        logger->setAppenderPipeline(pipeline, 1);
+
+        /* appender pipeline writes through, so that queued buffers are gathered by I/O thread */
+        auto file_appender =
+            std::make_shared<aw_logger::FileAppender>(file_path, true, pipeline ? 0 : 8192, backend);
+        logger->setAppender(file_appender);
+
+        long long elapsed = 0, syscalls = 0;
+        size_t bytes = 0;
+        for (int r = 0; r < ROUNDS; r++)
+        {
+            const size_t begin_size = file_appender->getFileSize();
+            const long long begin_syscalls = getWriteSyscallNum();
+            aw_test::TicToc timer;
+            timer.tic();
+            for (int i = 0; i < EVENTS; i++)
+            {
+                AW_LOG_FMT_INFO(logger, "Benchmark test message {}", i);
+            }
+            logger->flush();
+            elapsed += timer.toc();
+            syscalls += getWriteSyscallNum() - begin_syscalls;
+            bytes += file_appender->getFileSize() - begin_size;
+        }
+
+        std::cerr << std::fixed << std::setprecision(3);
+        std::cerr << label << ": " << bytes / (elapsed / 1e9) / (1024.0 * 1024.0) << " MB/s, "
+                  << static_cast<double>(syscalls) / ROUNDS << " write syscalls per " << EVENTS << " calls\n";
+
+        logger->setAppenderPipeline(false);
+        logger->clearAppenders();
+        std::remove(file_path.c_str());
+    };
+
+    run(backend_t::STREAM, false, "std::ofstream, worker thread");
+    run(backend_t::POSIX, false, "POSIX write, worker thread");
+    run(backend_t::STREAM, true, "std::ofstream, appender pipeline");
+    run(backend_t::POSIX, true, "POSIX writev, appender pipeline");
+    run(backend_t::MMAP, false, "mmap, worker thread");
+    run(backend_t::MMAP, true, "mmap, appender pipeline");
+    if (aw_logger::IoUring::isAvailable())
+    {
+        std::cerr << "NOTE: io_uring submissions are NOT counted as write syscalls\n";
+        run(backend_t::URING, false, "io_uring, worker thread");
+        run(backend_t::URING, true, "io_uring, appender pipeline");
+    }
+    SUCCEED();
+}
+
+/***
+ * @brief Benchmark: write latency across rotation boundaries with different numbers of backup files
+ */
+TEST(BenchmarkLogger, Rotation_Latency)
+{
+    const int ROTATIONS = 40;
+    const size_t MAX_FILE_SIZE = 1024 * 1024;
+    const std::string line(127, 'x');
+    const int CALLS = static_cast<int>(MAX_FILE_SIZE / (line.size() + 1)) * ROTATIONS;
+
+    std::cerr << "\n[Test 20] File appender, write latency across " << ROTATIONS << " rotations (" << CALLS
+              << " write-through calls)\n";
+
+    const auto run = [&](size_t backup_num) {
+        const std::string file_path = "/tmp/aw_rotation.log";
+        auto file_appender = std::make_shared<aw_logger::FileAppender>(
+            file_path,
+            true,
+            0,
+            aw_logger::FileAppender::ioBackend::POSIX
+        );
+        file_appender->setMaxFileSize(MAX_FILE_SIZE);
+        file_appender->setMaxBackupNum(backup_num);
+
+        aw_test::Latency all_stats, rotation_stats;
+        const std::string bytes = line + '\n';
+        for (int i = 0; i < CALLS; i++)
+        {
+            const size_t begin_size = file_appender->getFileSize();
+            aw_test::TicToc timer;
+            timer.tic();
+            file_appender->writeFormatted(bytes);
+            const auto elapsed = timer.toc();
+            all_stats.add(elapsed);
+
+            /* file size drops ONLY if this call rotates the file */
+            if (file_appender->getFileSize() < begin_size + bytes.size())
+                rotation_stats.add(elapsed);
+        }
+        file_appender->flush();
+
+        all_stats.print("all calls, " + std::to_string(backup_num) + " backups", std::cerr);
+        rotation_stats.print("rotating calls, " + std::to_string(backup_num) + " backups", std::cerr);
+
+        file_appender.reset();
+        std::remove(file_path.c_str());
+        for (size_t i = 1; i <= backup_num; i++)
+        {
+            std::remove(("/tmp/aw_rotation_backup" + std::to_string(i) + ".log").c_str());
+        }
+    };
+
+    run(1);
+    run(8);
+    run(32);
+    SUCCEED();
+}
+
 #endif //! TEST__LOAD_BENCHMARK_CPP
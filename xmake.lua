@@ -35,6 +35,13 @@ option("test")
     set_description("toggle on for awakelion logger unit tests with googletest.")
 option_end()
 
+option("active_level")
+    set_default("debug")
+    set_showmenu(true)
+    set_values("debug", "info", "notice", "warn", "error", "fatal", "off")
+    set_description("compile-time minimum log level, `AW_LOG_*` macros below it are stripped.")
+option_end()
+
 if has_config("test") then
     add_requires("gtest 1.17.0", {configs = {main = true}})
 end
@@ -55,6 +62,7 @@ namespace("fosu-awakelion")
         add_packages("ixwebsocket", {public = true})
 
         -- configuration
+        add_defines("AW_LOGGER_ACTIVE_LEVEL=AW_LOGGER_LEVEL_" .. string.upper(get_config("active_level") or "debug"), {public = true})
         set_configvar("SETTINGS_FILE_PATH", "")
         add_configfiles("config/settings_path.h.in", {
             filename = "aw_logger/settings_path.h",